@@ -17,8 +17,18 @@
 // C++ standard library headers
 #include <iostream>
 #include <string>
+#include <sstream>
 #include <vector>
-#include <map>
+#include <algorithm>
+
+// boost library headers
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/shared_ptr.hpp>
 
 // iRODS client library headers
 #include "rodsClient.h"
@@ -26,6 +36,8 @@
 
 // Kanki iRODS C++ class library headers
 #include "rodsconnection.h"
+#include "rodsconnectionpool.h"
+#include "rodsqueryresult.h"
 
 namespace Kanki {
 
@@ -34,23 +46,274 @@ class RodsGenQuery
 public:
 
     // Class local public enumerated type for query condition operators.
-    enum CondOpr { isEqual, isNotEqual, isLess, isLessOrEqual, isGreater, isGreaterOrEqual, isLike };
+    enum CondOpr { isEqual, isNotEqual, isLess, isLessOrEqual, isGreater, isGreaterOrEqual, isLike,
+                   isNotLike, isIn };
+
+    // Class local public enumerated type for query attribute select options, the server orders
+    // the result set by the attribute in ascending or descending order, or aggregates the attribute
+    // over the groups of the other (non-aggregated) attributes. Ordering and aggregation can be
+    // combined with a bitwise or.
+    enum SelectOpt { selectPlain = 0, orderAscending = ORDER_BY, orderDescending = ORDER_BY_DESC,
+                     selectMin = SELECT_MIN, selectMax = SELECT_MAX, selectSum = SELECT_SUM,
+                     selectAvg = SELECT_AVG, selectCount = SELECT_COUNT };
+
+    // Class local public class for a page of GenQuery results as received from the server. A page
+    // is a view to the rods api result buffers and only valid during the page handler invocation.
+    class Page
+    {
+    public:
+
+        // Constructor receives the rods api result buffers, the query attributes and the count
+        // of rows handed out from the buffers.
+        Page(const genQueryOut_t *theOutput, const std::vector<int> *theAttrs, int theRowCount);
+
+        // Returns the row count of the page.
+        int rowCount() const;
+
+        // Returns the attribute count of the page.
+        int attrCount() const;
+
+        // Interface for querying the attribute id at the specific index.
+        int attributeAtIndex(int attrIndex) const;
+
+        // Interface for accessing a result value at a row and attribute index, without copying.
+        const char* value(int row, int attrIndex) const;
+
+        // Interface for accessing a result value at a row for a rods attribute, without copying.
+        const char* valueForAttr(int row, int rodsAttr) const;
+
+    private:
+
+        // rods api result buffers
+        const genQueryOut_t *output;
+
+        // query attribute codes
+        const std::vector<int> *attrs;
+
+        // count of rows handed out
+        int rows;
+    };
+
+    // Class local public class for a partition of a query, a set of additional conditions which
+    // restrict the query into a subset of its results. Partitions of a query must be disjoint, except
+    // for a streaming execution with a page handler discarding duplicates, which executes the union
+    // of overlapping partitions (such as alternative condition groups).
+    class Partition
+    {
+    public:
+
+        // Adds a condition restricting the partition with a string value.
+        void addCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, const std::string &valStr);
+
+        // Adds the conditions of a query restricting the partition, the query is used only for
+        // building the conditions.
+        void addConditions(const RodsGenQuery &query);
+
+        // Returns the condition count of the partition.
+        unsigned int condCount() const;
+
+    private:
+
+        // the query applies the conditions
+        friend class RodsGenQuery;
+
+        // partition conditions as attribute ids, operators and values
+        std::vector<int> condAttrs;
+        std::vector<RodsGenQuery::CondOpr> condOprs;
+        std::vector<std::string> condVals;
+    };
+
+    // Class local public type for a page handler, invoked for each page of results as it arrives.
+    // Returning false stops the query and closes it on the server. The handler must not use the
+    // connection of the query: with page prefetch the next page is being requested on it while
+    // the handler runs, and the connection mutex held for the continuation is not recursive.
+    typedef boost::function<bool (const RodsGenQuery::Page &page)> PageHandler;
+
+    // Class local public class for an asynchronous execution of a query, a handle for following
+    // the progress of the execution and for cancelling it. Destroying the handle cancels the
+    // execution and waits for it to finish.
+    class Execution
+    {
+    public:
+
+        Execution();
+
+        ~Execution();
+
+        // Returns the count of result rows received so far.
+        size_t rowCount() const;
+
+        // Returns the count of result pages received so far.
+        unsigned int pageCount() const;
+
+        // Interface for querying whether the execution has finished, the results of the query
+        // may only be accessed after the execution has finished.
+        bool isFinished() const;
+
+        // Interface for querying whether the execution has been cancelled.
+        bool isCancelled() const;
+
+        // Requests cancelling the execution and returns without waiting. The execution stops when
+        // the page in transfer has been received, only then the query is closed on the server, as
+        // the connection is busy until the request completes. The rows received so far are kept.
+        void cancel();
+
+        // Waits for the execution to finish, returns the rods api status of the execution.
+        int wait();
+
+    private:
+
+        // the query runs the execution
+        friend class RodsGenQuery;
+
+        // we deny assignments and copying of the object
+        Execution(const Execution &);
+        Execution& operator=(const Execution &);
+
+        // counts a received page of rows, returns false if the execution is cancelled
+        bool pageReceived(int rows);
+
+        // marks the execution finished with a rods api status
+        void finish(int status);
+
+        // worker thread running the execution
+        boost::thread *worker;
+
+        // partitions of a partitioned execution
+        std::vector<RodsGenQuery::Partition> partitions;
+
+        // page handler of a streaming execution, empty when the results are stored
+        RodsGenQuery::PageHandler pageHandler;
+
+        // progress and state of the execution, protected by the mutex
+        mutable boost::mutex execMutex;
+        size_t rows;
+        unsigned int pages;
+        bool cancelled, finished;
+        int status;
+    };
+
+    // Class local public type for a shared pointer to an asynchronous execution handle.
+    typedef boost::shared_ptr<RodsGenQuery::Execution> ExecutionPtr;
 
     // Constructor receives only a pointer to a Kanki connection object for GenQuery execution.
     RodsGenQuery(Kanki::RodsConnection *theConn);
 
+    ~RodsGenQuery();
+
     // Adds a rods attribute into the GenQuery object for querying.
     void addQueryAttribute(int rodsAttr);
 
+    // Adds a rods attribute into the GenQuery object for querying with select options, for an
+    // attribute already added with the same aggregate the ordering options are updated. The same
+    // attribute can be added with different aggregates, the attribute index is the first one.
+    void addQueryAttribute(int rodsAttr, int selectOpts);
+
+    // Sets the count of result rows the server skips before returning results.
+    void setRowOffset(int offset);
+
+    // Sets the maximum count of result rows fetched, zero means no limit.
+    void setRowLimit(int limit);
+
+    // Sets the count of result rows requested per page (at most MAX_SQL_ROWS), zero means
+    // MAX_SQL_ROWS, reduced only for rows so wide that a page would exceed targetPageBytes.
+    void setPageSize(int rows);
+
+    // Sets whether the next page is requested while the current page is being consumed.
+    void setPagePrefetch(bool enabled);
+
     // Adds a query condition to the GenQuery with a string value.
     void addQueryCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, const std::string &valStr);
 
+    // Adds a query condition to the GenQuery with a list of string values, for the isIn operator.
+    // A list of one value is added as an equality condition. The server can't parse a value with
+    // a single quote in a longer list, such values are batched alone by makeValueBatches.
+    void addQueryCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, const std::vector<std::string> &valStrs);
+
     // Adds a query condition to the GenQuery with an integer value (converted to string).
     void addQueryCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, int val);
 
+    // Substitutes the value of the query condition at condition index. The rods api input
+    // is kept between executions, so re-executing with new values doesn't rebuild it.
+    void setConditionValue(unsigned int condIndex, const std::string &valStr);
+
+    // Sets the time in seconds the results of the query may be answered from the query result
+    // cache of the connection by execute, zero (the default) means the query isn't cached.
+    void setCacheTTL(int seconds);
+
+    // Returns the normalized signature of the query (attributes, conditions, offset and limit),
+    // equal for queries giving equal results.
+    std::string signature() const;
+
+    // Builds the rods api input for execution, done implicitly by the first execution.
+    // Adding attributes or conditions invalidates the prepared input.
+    void prepare();
+
     // Executes the iRODS GenQuery and fetches the results into local storage.
     int execute();
 
+    // Executes the iRODS GenQuery and hands out the results page by page to the page handler,
+    // without storing them. The connection is locked during the execution, so the handler
+    // must not use the same connection.
+    int executeStreaming(RodsGenQuery::PageHandler pageHandler);
+
+    // Executes the iRODS GenQuery as disjoint partitions in parallel on connections from a pool,
+    // and merges the results into local storage in the order of the partitions. The row offset
+    // is not supported and the row limit applies to the merged results.
+    int executePartitioned(Kanki::RodsConnectionPool *pool, const std::vector<RodsGenQuery::Partition> &partitions);
+
+    // Executes the iRODS GenQuery as disjoint partitions in parallel on connections from a pool,
+    // and hands out the results page by page to the page handler as they arrive. The handler is
+    // invoked concurrently from the worker threads and must be thread safe, the pages of different
+    // partitions arrive in no particular order and the row limit applies to each partition.
+    int executePartitionedStreaming(Kanki::RodsConnectionPool *pool,
+                                    const std::vector<RodsGenQuery::Partition> &partitions,
+                                    RodsGenQuery::PageHandler pageHandler);
+
+    // Executes the iRODS GenQuery in a worker thread and fetches the results into local storage,
+    // returns immediately with a handle to the execution. The query object must not be used or
+    // destroyed until the execution has finished.
+    RodsGenQuery::ExecutionPtr executeAsync();
+
+    // Executes the iRODS GenQuery as disjoint partitions in parallel in worker threads, as in
+    // executePartitioned, and returns immediately with a handle to the execution.
+    RodsGenQuery::ExecutionPtr executeAsync(Kanki::RodsConnectionPool *pool,
+                                            const std::vector<RodsGenQuery::Partition> &partitions);
+
+    // Executes the iRODS GenQuery in a worker thread and hands out the results page by page to
+    // the page handler, invoked in the worker thread, returns immediately with a handle to the
+    // execution. The results are not stored.
+    RodsGenQuery::ExecutionPtr executeAsync(RodsGenQuery::PageHandler pageHandler);
+
+    // Executes the iRODS GenQuery as disjoint partitions in parallel in worker threads, as in
+    // executePartitionedStreaming, and returns immediately with a handle to the execution.
+    RodsGenQuery::ExecutionPtr executeAsync(Kanki::RodsConnectionPool *pool,
+                                            const std::vector<RodsGenQuery::Partition> &partitions,
+                                            RodsGenQuery::PageHandler pageHandler);
+
+    // Makes partitions by collection paths, two for each given collection: one for the
+    // collection itself and one for the subtree below it.
+    static std::vector<RodsGenQuery::Partition> collectionPartitions(const std::vector<std::string> &collPaths);
+
+    // Makes partitions combining the conditions of each of the first partitions with each of the
+    // second ones, such as alternative condition groups with id ranges.
+    static std::vector<RodsGenQuery::Partition> combinePartitions(const std::vector<RodsGenQuery::Partition> &first,
+                                                                  const std::vector<RodsGenQuery::Partition> &second);
+
+    // Makes partitions by splitting the range [minVal, maxVal] of an integer attribute
+    // (such as COL_D_DATA_ID) into the given count of consecutive subranges.
+    static std::vector<RodsGenQuery::Partition> rangePartitions(int rodsAttr, rodsLong_t minVal, rodsLong_t maxVal,
+                                                                unsigned int count);
+
+    // Splits a list of values into batches of at most batchSize values for isIn conditions. A value
+    // containing a single quote gets a batch of its own, matched by an equality condition.
+    static std::vector<std::vector<std::string> > makeValueBatches(const std::vector<std::string> &valStrs,
+                                                                   unsigned int batchSize);
+
+    // Escapes the wildcards % and _ of a string (and the escape character) for a literal match in
+    // an isLike condition, with the backslash, the default escape of the catalog database.
+    static std::string escapeLike(const std::string &str);
+
     // Resets the GenQuery object.
     void reset();
 
@@ -66,6 +329,13 @@ public:
     // Interface for querying the attribute id at the specific index.
     int attributeAtIndex(int attrIndex) const;
 
+    // Interface for accessing the columnar query results without copying.
+    const Kanki::RodsQueryResult& result() const;
+
+    // Moves the query results into a result set object, leaving the query without results.
+    // The storage of the result set object is taken over by the query for reuse.
+    void takeResult(Kanki::RodsQueryResult *dest);
+
     // Interface for retrieving the query results for a given attribute rods api code.
     std::vector<std::string> getResultSetForAttr(int rodsAttr) const;
 
@@ -91,17 +361,97 @@ private:
         std::string valStr;
     };
 
+    // query objects own their rods api input, thus no copying
+    RodsGenQuery(const RodsGenQuery &);
+    RodsGenQuery& operator=(const RodsGenQuery &);
+
+    // frees the prepared rods api query input
+    void unprepare();
+
+    // formats the rods api condition string for a condition
+    static std::string formatCondition(const RodsGenQuery::Condition &cond);
+
+    // computes a page size for the continuation from the row width of a page, in practice
+    // MAX_SQL_ROWS clamped down only for rows wider than targetPageBytes / MAX_SQL_ROWS
+    static int tunePageSize(const genQueryOut_t *queryOutput);
+
+    // Class local private data structure for the state of the page fetch worker of a streaming
+    // execution, a request is made when requested is set and the worker exits when stopped.
+    struct PageFetch {
+        rcComm_t *commPtr;
+        genQueryInp_t *queryInput;
+        genQueryOut_t *queryOutput;
+        int status;
+        bool requested, stopped;
+        boost::mutex fetchMutex;
+        boost::condition_variable fetchCond;
+    };
+
+    // requests the pages of a streaming execution in a worker thread, one at a time
+    static void fetchPages(RodsGenQuery::PageFetch *fetch);
+
+    // stores a page of results into the local storage
+    bool storePage(const RodsGenQuery::Page &page);
+
+    // hands out a page of results to a page handler, reporting progress to the execution
+    bool streamPage(const RodsGenQuery::PageHandler &pageHandler, const RodsGenQuery::Page &page);
+
+    // Class local private data structure for the shared state of a partitioned execution.
+    struct PartitionJob {
+        Kanki::RodsConnectionPool *pool;
+        const std::vector<RodsGenQuery::Partition> *partitions;
+        RodsGenQuery::PageHandler pageHandler;
+        std::vector<Kanki::RodsQueryResult> partResults;
+        std::vector<int> partStatus;
+        unsigned int nextPartition;
+        boost::mutex jobMutex;
+    };
+
+    // runs the worker threads of a partitioned execution until all partitions are executed
+    void runPartitions(RodsGenQuery::PartitionJob *job) const;
+
+    // executes partitions of a partitioned execution until there are none left
+    void executePartitions(RodsGenQuery::PartitionJob *job) const;
+
+    // runs an asynchronous execution in its worker thread
+    void executeWorker(RodsGenQuery::Execution *exec, Kanki::RodsConnectionPool *pool);
+
     // pointer to Kanki rods connection object
     Kanki::RodsConnection *conn;
 
     // container for rods query attribute codes
     std::vector<int> queryAttrs;
 
+    // container for rods query attribute select options
+    std::vector<int> queryAttrOpts;
+
+    // result row offset and limit
+    int rowOffset, rowLimit;
+
+    // result page size and whether to prefetch the next page
+    int pageSize;
+    bool pagePrefetch;
+
+    // time to live of cached results in seconds, zero for no caching
+    int cacheTTL;
+
+    // target size in bytes and minimum row count of a page with wide rows
+    static const size_t targetPageBytes;
+    static const int minPageRows;
+
     // container for query conditions
     std::vector<RodsGenQuery::Condition> queryConds;
 
-    // hashtable container for query results
-    std::map< int, std::vector<std::string> > resultTable;
+    // prepared rods api input and storage for its condition strings
+    genQueryInp_t preparedInput;
+    std::vector<std::string> condStrs;
+    bool prepared;
+
+    // columnar container for query results
+    Kanki::RodsQueryResult results;
+
+    // asynchronous execution being run, if any
+    RodsGenQuery::Execution *execution;
 };
 
 } // namespace Kanki
@@ -0,0 +1,173 @@
+/**
+ * @file treemodelbench.cpp
+ * @brief Synthetic benchmark of the iRODS object tree models
+ *
+ * Builds a synthetic object tree of collections of data objects both as
+ * RodsObjTreeItem items and into a RodsObjFlatTreeModel, and times the
+ * construction and a full traversal of each. Built with qmake CONFIG+=bench,
+ * run headless with -platform offscreen. The optional arguments are the
+ * count of collections and the count of data objects per collection,
+ * by default 1000 collections of 999 data objects (1M nodes).
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// C++ standard library headers
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+// ANSI C standard library headers
+#include <cstdlib>
+
+// Qt framework headers
+#include <QApplication>
+#include <QStringList>
+#include <QVariant>
+
+// Kanki iRODS C++ class library headers
+#include "rodsobjentry.h"
+
+// application headers
+#include "rodsobjtreeitem.h"
+#include "rodsobjflattreemodel.h"
+
+typedef std::chrono::high_resolution_clock BenchClock;
+
+// makes a synthetic collection listing, subcollections first as rods lists them
+static void makeListing(const std::string &collPath, int collCount, int dataCount,
+                        std::vector<Kanki::RodsObjEntryPtr> *listing)
+{
+    listing->clear();
+
+    for (int i = 0; i < collCount; i++)
+    {
+        std::string path = collPath + "/coll" + QVariant(i).toString().toStdString();
+
+        listing->push_back(Kanki::RodsObjEntryPtr(new Kanki::RodsObjEntry(path, path, "1451606400", "1451606400",
+                                                                          COLL_OBJ_T, 0, 0, 0)));
+    }
+
+    for (int i = 0; i < dataCount; i++)
+    {
+        std::string name = "data" + QVariant(i).toString().toStdString() + ".dat";
+
+        listing->push_back(Kanki::RodsObjEntryPtr(new Kanki::RodsObjEntry(name, collPath, "1451606400", "1451606400",
+                                                                          DATA_OBJ_T, 0, 1, 1024 * (i + 1))));
+    }
+}
+
+// traverses an item and its descendants, querying the data of every column
+static size_t traverseItem(RodsObjTreeItem *item)
+{
+    size_t nodes = 1;
+
+    for (int col = 0; col < RodsObjTreeItem::numColumns; col++)
+        item->data(col);
+
+    for (int i = 0; i < item->childCount(); i++)
+        nodes += traverseItem(item->child(i));
+
+    return (nodes);
+}
+
+// traverses a model index and its descendants through index() and data() of every column
+static size_t traverseIndex(QAbstractItemModel *model, const QModelIndex &parent)
+{
+    size_t nodes = 0;
+
+    for (int row = 0; row < model->rowCount(parent); row++)
+    {
+        for (int col = 0; col < model->columnCount(parent); col++)
+            model->data(model->index(row, col, parent), Qt::DisplayRole);
+
+        nodes += 1 + traverseIndex(model, model->index(row, 0, parent));
+    }
+
+    return (nodes);
+}
+
+static double elapsedMs(BenchClock::time_point t0)
+{
+    return (std::chrono::duration_cast<std::chrono::microseconds>(BenchClock::now() - t0).count() / 1000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    // the flat model uses Qt icons, which require an application object
+    QApplication a(argc, argv);
+    QStringList args = a.arguments();
+
+    int collCount = args.size() > 1 ? args.at(1).toInt() : 1000;
+    int dataCount = args.size() > 2 ? args.at(2).toInt() : 999;
+
+    std::vector<Kanki::RodsObjEntryPtr> listing;
+    double itemBuild = 0, flatBuild = 0;
+    BenchClock::time_point t0;
+
+    RodsObjTreeItem *rootItem = new RodsObjTreeItem(NULL);
+    RodsObjTreeItem *mountItem = new RodsObjTreeItem(rootItem);
+    RodsObjFlatTreeModel flatModel(NULL, "/bench");
+    QModelIndex mountIndex = flatModel.index(0, 0, QModelIndex());
+
+    mountItem->setMountPoint("/bench");
+    rootItem->appendChild(mountItem);
+
+    // the mount point lists the collections
+    makeListing("/bench", collCount, 0, &listing);
+
+    t0 = BenchClock::now();
+
+    for (unsigned int i = 0; i < listing.size(); i++)
+        mountItem->appendChild(new RodsObjTreeItem(listing.at(i), mountItem));
+
+    itemBuild += elapsedMs(t0);
+
+    t0 = BenchClock::now();
+    flatModel.setListing(mountIndex, listing);
+    flatBuild += elapsedMs(t0);
+
+    // each collection lists its data objects, the listings are made outside of the timing
+    for (int i = 0; i < collCount; i++)
+    {
+        RodsObjTreeItem *collItem = mountItem->child(i);
+
+        makeListing(collItem->getObjEntryPtr()->objName, 0, dataCount, &listing);
+
+        t0 = BenchClock::now();
+
+        for (unsigned int j = 0; j < listing.size(); j++)
+            collItem->appendChild(new RodsObjTreeItem(listing.at(j), collItem));
+
+        itemBuild += elapsedMs(t0);
+
+        t0 = BenchClock::now();
+        flatModel.setListing(flatModel.index(i, 0, mountIndex), listing);
+        flatBuild += elapsedMs(t0);
+    }
+
+    listing.clear();
+
+    t0 = BenchClock::now();
+    size_t itemNodes = traverseItem(mountItem);
+    double itemWalk = elapsedMs(t0);
+
+    t0 = BenchClock::now();
+    size_t flatNodes = traverseIndex(&flatModel, QModelIndex());
+    double flatWalk = elapsedMs(t0);
+
+    std::cout << "nodes: " << itemNodes << " (items), " << flatNodes << " (flat)" << std::endl;
+    std::cout << "RodsObjTreeItem construction: " << itemBuild << " ms, traversal: " << itemWalk << " ms" << std::endl;
+    std::cout << "RodsObjFlatTreeModel construction: " << flatBuild << " ms, index()/data() traversal: "
+              << flatWalk << " ms" << std::endl;
+
+    t0 = BenchClock::now();
+    delete (rootItem);
+    std::cout << "RodsObjTreeItem destruction: " << elapsedMs(t0) << " ms" << std::endl;
+
+    return (EXIT_SUCCESS);
+}
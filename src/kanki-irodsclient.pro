@@ -47,7 +47,23 @@ SOURCES += main.cpp\
     rodsstringconditionwidget.cpp \
     rodsconditionwidget.cpp \
     rodsdateconditionwidget.cpp \
-    rodsmetadataconditionwidget.cpp
+    rodsmetadataconditionwidget.cpp \
+    rodsobjtreestore.cpp \
+    rodsobjflattreemodel.cpp \
+    rodscolltablemodel.cpp \
+    rodscolltablewindow.cpp \
+    rodsprefetchthread.cpp \
+    rodsqueryresult.cpp \
+    rodsconnectionpool.cpp \
+    rodsmetadatabatch.cpp \
+    rodsspecificquery.cpp \
+    rodsquerycache.cpp \
+    rodsfindresultmodel.cpp \
+    rodsnameindex.cpp \
+    rodsavuindex.cpp \
+    rodsmetadatafacets.cpp \
+    rodsobjexport.cpp \
+    rodsexportthread.cpp
 
 HEADERS  += rodsmainwindow.h \
     rodsconnection.h \
@@ -75,7 +91,23 @@ HEADERS  += rodsmainwindow.h \
     rodsconditionwidget.h \
     rodsstringconditionwidget.h \
     rodsdateconditionwidget.h \
-    rodsmetadataconditionwidget.h
+    rodsmetadataconditionwidget.h \
+    rodsobjtreestore.h \
+    rodsobjflattreemodel.h \
+    rodscolltablemodel.h \
+    rodscolltablewindow.h \
+    rodsprefetchthread.h \
+    rodsqueryresult.h \
+    rodsconnectionpool.h \
+    rodsmetadatabatch.h \
+    rodsspecificquery.h \
+    rodsquerycache.h \
+    rodsfindresultmodel.h \
+    rodsnameindex.h \
+    rodsavuindex.h \
+    rodsmetadatafacets.h \
+    rodsobjexport.h \
+    rodsexportthread.h
 
 FORMS    += rodsmainwindow.ui \
     rodsmetadatawindow.ui \
@@ -85,6 +117,16 @@ FORMS    += rodsmainwindow.ui \
 RESOURCES += \
     icons.qrc
 
+# synthetic benchmark of the object tree models, built with qmake CONFIG+=bench
+bench {
+    TARGET = treemodelbench
+    CONFIG += console
+    CONFIG -= app_bundle
+
+    SOURCES -= main.cpp
+    SOURCES += bench/treemodelbench.cpp
+}
+
 OTHER_FILES += \
     irods.icns \
     AppConfig.plist \
@@ -161,7 +203,10 @@ macx {
     }
 
     QMAKE_EXTRA_TARGETS += target_icommands #target_auth_plugins target_network_plugins
-    PRE_TARGETDEPS += target_icommands #target_auth_plugins target_network_plugins
+
+    !bench {
+        PRE_TARGETDEPS += target_icommands #target_auth_plugins target_network_plugins
+    }
 
     QMAKE_BUNDLE_DATA += SCHEMA_XML
     QMAKE_BUNDLE_DATA += IRODS_PLUGINS_AUTH_LIBS
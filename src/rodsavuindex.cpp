@@ -0,0 +1,513 @@
+/**
+ * @file rodsavuindex.cpp
+ * @brief Implementation of Kanki library class RodsAVUIndex
+ *
+ * The Kanki class RodsAVUIndex implements a local inverted index of the
+ * iRODS AVU metadata of the data objects in a collection subtree, for
+ * facet counts and combined metadata filters without server queries.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsAVUIndex header
+#include "rodsavuindex.h"
+
+namespace Kanki {
+
+RodsAVUIndex::RodsAVUIndex(Kanki::RodsConnection *theConn)
+{
+    this->conn = theConn;
+    this->lastModify = 0;
+}
+
+int RodsAVUIndex::load(const std::string &collPath)
+{
+    int status = 0;
+
+    this->clear();
+    this->rootPath = collPath;
+
+    // the data objects in the collection itself and below it, one row per AVU
+    for (int below = 0; below < 2; below++)
+    {
+        Kanki::RodsGenQuery query(this->conn);
+        this->addSubtreeCondition(&query, below);
+
+        if ((status = this->loadDataObjs(&query)) < 0)
+            return (status);
+    }
+
+    return (status);
+}
+
+int RodsAVUIndex::refresh()
+{
+    std::ostringstream sinceStr;
+    std::vector<std::string> dataIds;
+    int status = 0;
+
+    if (this->rootPath.empty())
+        return (status);
+
+    // times are compared as zero padded strings
+    sinceStr << std::setw(11) << std::setfill('0') << this->lastModify;
+    this->changedObjs.clear();
+
+    // the objects with AVUs modified at or after the latest modification seen
+    for (int below = 0; below < 2; below++)
+    {
+        Kanki::RodsGenQuery query(this->conn);
+
+        query.addQueryAttribute(COL_D_DATA_ID);
+        query.addQueryAttribute(COL_COLL_NAME);
+        query.addQueryAttribute(COL_DATA_NAME);
+        query.addQueryAttribute(COL_META_DATA_MODIFY_TIME);
+
+        this->addSubtreeCondition(&query, below);
+        query.addQueryCondition(COL_META_DATA_MODIFY_TIME, Kanki::RodsGenQuery::isGreaterOrEqual, sinceStr.str());
+
+        if ((status = query.executeStreaming(boost::bind(&RodsAVUIndex::storeChangedPage, this, _1))) < 0)
+            return (status);
+    }
+
+    this->presentObjs.assign(this->objPaths.size(), false);
+
+    // the objects with AVUs in the subtree now, one row per object, to find the objects
+    // deleted or moved away and the ones moved in, whose AVUs are unmodified
+    for (int below = 0; below < 2; below++)
+    {
+        Kanki::RodsGenQuery query(this->conn);
+
+        query.addQueryAttribute(COL_D_DATA_ID);
+        query.addQueryAttribute(COL_COLL_NAME);
+        query.addQueryAttribute(COL_DATA_NAME);
+
+        this->addSubtreeCondition(&query, below);
+        query.addQueryCondition(COL_META_DATA_ATTR_NAME, Kanki::RodsGenQuery::isLike, "%");
+
+        if ((status = query.executeStreaming(boost::bind(&RodsAVUIndex::storePresentPage, this, _1))) < 0)
+            return (status);
+    }
+
+    for (unsigned int i = 0; i < this->presentObjs.size(); i++)
+    {
+        if (!this->presentObjs.at(i) && !this->objPaths.at(i).empty())
+            this->removeObject(i);
+    }
+
+    this->presentObjs.clear();
+    this->compact();
+
+    if (this->changedObjs.empty())
+        return (status);
+
+    // all the AVUs of the changed objects are reloaded in batches
+    for (std::map<std::string, std::string>::iterator i = this->changedObjs.begin(); i != this->changedObjs.end(); i++)
+        dataIds.push_back(i->second);
+
+    Kanki::RodsMetadataBatch batch(this->conn);
+
+    if ((status = batch.loadDataIds(dataIds)) < 0)
+        return (status);
+
+    for (std::map<std::string, std::string>::iterator i = this->changedObjs.begin(); i != this->changedObjs.end(); i++)
+    {
+        const Kanki::RodsObjMetadata::AVUs &avus = batch.avus(i->first);
+        unsigned int objId = this->objectId(i->first);
+
+        this->removeAVUs(objId);
+
+        for (unsigned int j = 0; j < avus.size(); j++)
+            this->addAVU(objId, avus.at(j).name, avus.at(j).value);
+    }
+
+    this->changedObjs.clear();
+
+    return (status);
+}
+
+const std::string& RodsAVUIndex::collPath() const
+{
+    return (this->rootPath);
+}
+
+size_t RodsAVUIndex::objectCount() const
+{
+    size_t count = 0;
+
+    for (unsigned int i = 0; i < this->objAVUs.size(); i++)
+    {
+        if (!this->objAVUs.at(i).empty())
+            count++;
+    }
+
+    return (count);
+}
+
+RodsAVUIndex::Selection RodsAVUIndex::all() const
+{
+    RodsAVUIndex::Selection selection;
+
+    // objects whose AVUs have all been removed stay indexed without AVUs
+    for (unsigned int i = 0; i < this->objAVUs.size(); i++)
+    {
+        if (!this->objAVUs.at(i).empty())
+            selection.push_back(i);
+    }
+
+    return (selection);
+}
+
+RodsAVUIndex::Selection RodsAVUIndex::select(const std::vector<RodsAVUIndex::AnyOf> &allOf) const
+{
+    RodsAVUIndex::Selection selection;
+
+    if (allOf.empty())
+        return (this->all());
+
+    for (unsigned int i = 0; i < allOf.size(); i++)
+    {
+        RodsAVUIndex::Selection groupSel;
+
+        // a group selects the union of the objects of its terms
+        for (unsigned int j = 0; j < allOf.at(i).size(); j++)
+        {
+            const RodsAVUIndex::Term &term = allOf.at(i).at(j);
+            const std::vector<unsigned int> *ids = NULL;
+
+            if (term.value.empty())
+            {
+                boost::unordered_map<std::string, std::vector<unsigned int> >::const_iterator attr =
+                        this->attrIds.find(term.attr);
+
+                if (attr != this->attrIds.end())
+                    ids = &attr->second;
+            }
+
+            else {
+                boost::unordered_map<std::string, boost::unordered_map<std::string, std::vector<unsigned int> > >::const_iterator
+                        attr = this->valueIds.find(term.attr);
+
+                if (attr != this->valueIds.end())
+                {
+                    boost::unordered_map<std::string, std::vector<unsigned int> >::const_iterator value =
+                            attr->second.find(term.value);
+
+                    if (value != attr->second.end())
+                        ids = &value->second;
+                }
+            }
+
+            if (!ids)
+                continue;
+
+            RodsAVUIndex::Selection merged;
+
+            std::set_union(groupSel.begin(), groupSel.end(), ids->begin(), ids->end(), std::back_inserter(merged));
+            groupSel.swap(merged);
+        }
+
+        // the groups are intersected
+        if (!i)
+            selection.swap(groupSel);
+
+        else {
+            RodsAVUIndex::Selection common;
+
+            std::set_intersection(selection.begin(), selection.end(), groupSel.begin(), groupSel.end(),
+                                  std::back_inserter(common));
+            selection.swap(common);
+        }
+
+        if (selection.empty())
+            break;
+    }
+
+    return (selection);
+}
+
+RodsAVUIndex::Counts RodsAVUIndex::attributeCounts(const RodsAVUIndex::Selection &within) const
+{
+    RodsAVUIndex::Counts counts;
+
+    for (unsigned int i = 0; i < within.size(); i++)
+    {
+        const std::vector<RodsAVUIndex::AVU> &avus = this->objAVUs.at(within.at(i));
+        std::vector<std::string> attrs;
+
+        // an object is counted once for an attribute with many values
+        for (unsigned int j = 0; j < avus.size(); j++)
+            attrs.push_back(avus.at(j).first);
+
+        std::sort(attrs.begin(), attrs.end());
+        attrs.erase(std::unique(attrs.begin(), attrs.end()), attrs.end());
+
+        for (unsigned int j = 0; j < attrs.size(); j++)
+            counts[attrs.at(j)]++;
+    }
+
+    return (counts);
+}
+
+RodsAVUIndex::Counts RodsAVUIndex::valueCounts(const std::string &attr, const RodsAVUIndex::Selection &within) const
+{
+    RodsAVUIndex::Counts counts;
+
+    // the AVUs of an object are distinct, so each value is counted once per object
+    for (unsigned int i = 0; i < within.size(); i++)
+    {
+        const std::vector<RodsAVUIndex::AVU> &avus = this->objAVUs.at(within.at(i));
+
+        for (unsigned int j = 0; j < avus.size(); j++)
+        {
+            if (avus.at(j).first == attr)
+                counts[avus.at(j).second]++;
+        }
+    }
+
+    return (counts);
+}
+
+const std::string& RodsAVUIndex::objectPath(unsigned int objId) const
+{
+    return (this->objPaths.at(objId));
+}
+
+void RodsAVUIndex::clear()
+{
+    this->rootPath.clear();
+    this->lastModify = 0;
+
+    this->objPaths.clear();
+    this->objAVUs.clear();
+    this->objIds.clear();
+    this->attrIds.clear();
+    this->valueIds.clear();
+    this->changedObjs.clear();
+    this->presentObjs.clear();
+}
+
+int RodsAVUIndex::loadDataObjs(Kanki::RodsGenQuery *query)
+{
+    // the object path, its AVUs and their modify times, one row per AVU
+    query->addQueryAttribute(COL_COLL_NAME);
+    query->addQueryAttribute(COL_DATA_NAME);
+    query->addQueryAttribute(COL_META_DATA_ATTR_NAME);
+    query->addQueryAttribute(COL_META_DATA_ATTR_VALUE);
+    query->addQueryAttribute(COL_META_DATA_MODIFY_TIME);
+
+    // results are indexed page by page, without an intermediate result table
+    return (query->executeStreaming(boost::bind(&RodsAVUIndex::storePage, this, _1)));
+}
+
+bool RodsAVUIndex::storePage(const Kanki::RodsGenQuery::Page &page)
+{
+    std::string objPath;
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        // columns are in the order of the query attributes
+        objPath = page.value(i, 0);
+
+        if (objPath.empty() || objPath.at(objPath.length() - 1) != '/')
+            objPath += "/";
+
+        objPath += page.value(i, 1);
+
+        this->addAVU(this->objectId(objPath), page.value(i, 2), page.value(i, 3));
+        this->updateModifyTime(page.value(i, 4));
+    }
+
+    return (true);
+}
+
+bool RodsAVUIndex::storeChangedPage(const Kanki::RodsGenQuery::Page &page)
+{
+    std::string objPath;
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        objPath = page.value(i, 1);
+
+        if (objPath.empty() || objPath.at(objPath.length() - 1) != '/')
+            objPath += "/";
+
+        objPath += page.value(i, 2);
+
+        this->changedObjs[objPath] = page.value(i, 0);
+        this->updateModifyTime(page.value(i, 3));
+    }
+
+    return (true);
+}
+
+bool RodsAVUIndex::storePresentPage(const Kanki::RodsGenQuery::Page &page)
+{
+    std::string objPath;
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        objPath = page.value(i, 1);
+
+        if (objPath.empty() || objPath.at(objPath.length() - 1) != '/')
+            objPath += "/";
+
+        objPath += page.value(i, 2);
+
+        boost::unordered_map<std::string, unsigned int>::iterator obj = this->objIds.find(objPath);
+
+        // an object not indexed at its path has been moved or renamed, its AVUs are loaded
+        if (obj == this->objIds.end())
+            this->changedObjs[objPath] = page.value(i, 0);
+
+        else if (obj->second < this->presentObjs.size())
+            this->presentObjs.at(obj->second) = true;
+    }
+
+    return (true);
+}
+
+void RodsAVUIndex::removeObject(unsigned int objId)
+{
+    this->removeAVUs(objId);
+    this->objIds.erase(this->objPaths.at(objId));
+    this->objPaths.at(objId).clear();
+}
+
+void RodsAVUIndex::compact()
+{
+    // the ids left unused by removed objects are reclaimed once they are the majority
+    if (this->objPaths.size() - this->objIds.size() <= this->objIds.size())
+        return;
+
+    std::vector<std::string> paths;
+    std::vector< std::vector<RodsAVUIndex::AVU> > avus;
+
+    paths.swap(this->objPaths);
+    avus.swap(this->objAVUs);
+
+    this->objIds.clear();
+    this->attrIds.clear();
+    this->valueIds.clear();
+
+    // the live objects are indexed again in their order, their ids stay ascending
+    for (unsigned int i = 0; i < paths.size(); i++)
+    {
+        if (paths.at(i).empty())
+            continue;
+
+        unsigned int objId = this->objectId(paths.at(i));
+
+        for (unsigned int j = 0; j < avus.at(i).size(); j++)
+            this->addAVU(objId, avus.at(i).at(j).first, avus.at(i).at(j).second);
+    }
+}
+
+void RodsAVUIndex::addSubtreeCondition(Kanki::RodsGenQuery *query, bool below) const
+{
+    if (!below)
+    {
+        query->addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, this->rootPath);
+        return;
+    }
+
+    std::string prefix = this->rootPath;
+
+    if (prefix.empty() || prefix.at(prefix.length() - 1) != '/')
+        prefix += "/";
+
+    query->addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isLike, Kanki::RodsGenQuery::escapeLike(prefix) + "%");
+}
+
+unsigned int RodsAVUIndex::objectId(const std::string &objPath)
+{
+    boost::unordered_map<std::string, unsigned int>::iterator obj = this->objIds.find(objPath);
+
+    if (obj != this->objIds.end())
+        return (obj->second);
+
+    unsigned int objId = this->objPaths.size();
+
+    this->objPaths.push_back(objPath);
+    this->objAVUs.push_back(std::vector<RodsAVUIndex::AVU>());
+    this->objIds[objPath] = objId;
+
+    return (objId);
+}
+
+void RodsAVUIndex::addAVU(unsigned int objId, const std::string &attr, const std::string &value)
+{
+    std::vector<RodsAVUIndex::AVU> &avus = this->objAVUs.at(objId);
+    RodsAVUIndex::AVU avu(attr, value);
+
+    // AVUs differing only by units are indexed once
+    if (std::find(avus.begin(), avus.end(), avu) != avus.end())
+        return;
+
+    avus.push_back(avu);
+
+    RodsAVUIndex::insertId(&this->attrIds[attr], objId);
+    RodsAVUIndex::insertId(&this->valueIds[attr][value], objId);
+}
+
+void RodsAVUIndex::removeAVUs(unsigned int objId)
+{
+    std::vector<RodsAVUIndex::AVU> &avus = this->objAVUs.at(objId);
+
+    for (unsigned int i = 0; i < avus.size(); i++)
+    {
+        const std::string &attr = avus.at(i).first;
+        boost::unordered_map<std::string, std::vector<unsigned int> > &values = this->valueIds[attr];
+
+        RodsAVUIndex::eraseId(&values[avus.at(i).second], objId);
+        RodsAVUIndex::eraseId(&this->attrIds[attr], objId);
+
+        // attributes and values without objects are dropped
+        if (values[avus.at(i).second].empty())
+            values.erase(avus.at(i).second);
+
+        if (values.empty())
+        {
+            this->valueIds.erase(attr);
+            this->attrIds.erase(attr);
+        }
+    }
+
+    avus.clear();
+}
+
+void RodsAVUIndex::updateModifyTime(const char *timeStr)
+{
+    time_t modifyTime = atol(timeStr);
+
+    if (modifyTime > this->lastModify)
+        this->lastModify = modifyTime;
+}
+
+void RodsAVUIndex::insertId(std::vector<unsigned int> *ids, unsigned int objId)
+{
+    // rows mostly arrive object by object, so ids are mostly appended
+    if (ids->empty() || ids->back() < objId)
+    {
+        ids->push_back(objId);
+        return;
+    }
+
+    std::vector<unsigned int>::iterator pos = std::lower_bound(ids->begin(), ids->end(), objId);
+
+    if (pos == ids->end() || *pos != objId)
+        ids->insert(pos, objId);
+}
+
+void RodsAVUIndex::eraseId(std::vector<unsigned int> *ids, unsigned int objId)
+{
+    std::vector<unsigned int>::iterator pos = std::lower_bound(ids->begin(), ids->end(), objId);
+
+    if (pos != ids->end() && *pos == objId)
+        ids->erase(pos);
+}
+
+} // namespace Kanki
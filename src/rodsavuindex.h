@@ -0,0 +1,166 @@
+/**
+ * @file rodsavuindex.h
+ * @brief Definition of Kanki library class RodsAVUIndex
+ *
+ * The Kanki class RodsAVUIndex implements a local inverted index of the
+ * iRODS AVU metadata of the data objects in a collection subtree, for
+ * facet counts and combined metadata filters without server queries.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSAVUINDEX_H
+#define RODSAVUINDEX_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <iomanip>
+
+// ANSI C standard library headers
+#include <cstdlib>
+#include <ctime>
+
+// boost library headers
+#include <boost/unordered_map.hpp>
+#include <boost/bind.hpp>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsmetadatabatch.h"
+#include "_rodsgenquery.h"
+
+namespace Kanki {
+
+class RodsAVUIndex
+{
+public:
+
+    // Class local public data structure for a filter term, matching the objects with an
+    // attribute and value, or with any value of the attribute for an empty value.
+    struct Term {
+        std::string attr, value;
+    };
+
+    // Class local public type for a filter group, matching the objects matching any of its terms.
+    typedef std::vector<RodsAVUIndex::Term> AnyOf;
+
+    // Class local public type for a selection of objects, as ascending object ids.
+    typedef std::vector<unsigned int> Selection;
+
+    // Class local public type for facet counts, object counts by attribute or value.
+    typedef std::map<std::string, unsigned int> Counts;
+
+    // Constructor requires a pointer to a Kanki rods connection object.
+    RodsAVUIndex(Kanki::RodsConnection *theConn);
+
+    // Loads the AVUs of all the data objects in a collection subtree, replacing the index.
+    // Returns rods api status code.
+    int load(const std::string &collPath);
+
+    // Reloads the AVUs of the objects with AVUs modified since the last load or refresh, and of
+    // the objects moved or renamed into the subtree. Objects deleted or moved away, or with all
+    // of their AVUs removed, are dropped. Some AVUs removed from otherwise unchanged objects are
+    // noticed by a full load only. Returns rods api status code.
+    int refresh();
+
+    // Interface for accessing the path of the indexed collection subtree, empty if not loaded.
+    const std::string& collPath() const;
+
+    // Returns the count of indexed objects with AVUs.
+    size_t objectCount() const;
+
+    // Selects all the indexed objects with AVUs.
+    RodsAVUIndex::Selection all() const;
+
+    // Selects the objects matching all of the filter groups, all objects for no groups.
+    RodsAVUIndex::Selection select(const std::vector<RodsAVUIndex::AnyOf> &allOf) const;
+
+    // Counts the objects of a selection having each attribute.
+    RodsAVUIndex::Counts attributeCounts(const RodsAVUIndex::Selection &within) const;
+
+    // Counts the objects of a selection having each value of an attribute.
+    RodsAVUIndex::Counts valueCounts(const std::string &attr, const RodsAVUIndex::Selection &within) const;
+
+    // Interface for accessing the full rods path of an indexed object by its id.
+    const std::string& objectPath(unsigned int objId) const;
+
+    // Clears the index.
+    void clear();
+
+private:
+
+    // Class local private type for an AVU of an object, its attribute and value.
+    typedef std::pair<std::string, std::string> AVU;
+
+    // loads the AVUs of the data objects matching the conditions of a query
+    int loadDataObjs(Kanki::RodsGenQuery *query);
+
+    // adds the AVUs from a page of query results
+    bool storePage(const Kanki::RodsGenQuery::Page &page);
+
+    // collects the objects with modified AVUs from a page of query results
+    bool storeChangedPage(const Kanki::RodsGenQuery::Page &page);
+
+    // marks the indexed objects present in a page of query results, collecting the others as changed
+    bool storePresentPage(const Kanki::RodsGenQuery::Page &page);
+
+    // drops an object and its AVUs, its id is left unused
+    void removeObject(unsigned int objId);
+
+    // renumbers the objects once the unused ids outnumber the indexed objects
+    void compact();
+
+    // adds subtree conditions to a query, for the collection itself or below it
+    void addSubtreeCondition(Kanki::RodsGenQuery *query, bool below) const;
+
+    // returns the id of an object, adding the object if not yet indexed
+    unsigned int objectId(const std::string &objPath);
+
+    // adds and removes an AVU of an object
+    void addAVU(unsigned int objId, const std::string &attr, const std::string &value);
+    void removeAVUs(unsigned int objId);
+
+    // keeps track of the latest AVU modify time
+    void updateModifyTime(const char *timeStr);
+
+    // inserts and erases an object id in an ascending id list
+    static void insertId(std::vector<unsigned int> *ids, unsigned int objId);
+    static void eraseId(std::vector<unsigned int> *ids, unsigned int objId);
+
+    // pointer to Kanki rods connection object
+    Kanki::RodsConnection *conn;
+
+    // indexed collection subtree and the latest AVU modify time seen
+    std::string rootPath;
+    time_t lastModify;
+
+    // object paths and AVUs by id, and object ids by path
+    std::vector<std::string> objPaths;
+    std::vector< std::vector<RodsAVUIndex::AVU> > objAVUs;
+    boost::unordered_map<std::string, unsigned int> objIds;
+
+    // ascending object ids by attribute, and by attribute and value
+    boost::unordered_map<std::string, std::vector<unsigned int> > attrIds;
+    boost::unordered_map<std::string, boost::unordered_map<std::string, std::vector<unsigned int> > > valueIds;
+
+    // objects with modified AVUs and their data object ids, and the indexed objects still
+    // present on the server by id, collected by refresh
+    std::map<std::string, std::string> changedObjs;
+    std::vector<bool> presentObjs;
+};
+
+} // namespace Kanki
+
+#endif // RODSAVUINDEX_H
@@ -0,0 +1,309 @@
+/**
+ * @file rodscolltablemodel.cpp
+ * @brief Implementation of class RodsCollTableModel
+ *
+ * The class RodsCollTableModel extends the Qt model class QAbstractTableModel
+ * and implements a paged table model for the data objects of an iRODS collection,
+ * with sorting and name filtering executed on the iRODS server.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsCollTableModel header
+#include "rodscolltablemodel.h"
+
+// initialize static class constants
+const int RodsCollTableModel::pageSize = 256;
+const int RodsCollTableModel::numColumns = 5;
+const int RodsCollTableModel::columnAttrs[RodsCollTableModel::numColumns] = { COL_DATA_NAME, COL_DATA_SIZE, COL_D_CREATE_TIME,
+                                                COL_D_MODIFY_TIME, COL_DATA_REPL_NUM };
+
+RodsCollTableModel::RodsCollTableModel(Kanki::RodsConnection *conn, const std::string &collPath, QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    // set iRODS connection object pointer and collection path
+    this->rodsConn = conn;
+    this->path = collPath;
+
+    // by default, sort by name in ascending order
+    this->sortColumn = 0;
+    this->sortOrder = Qt::AscendingOrder;
+    this->atEnd = false;
+
+    this->dataIcon = QIcon(":/tango/icons/text-x-generic.png");
+}
+
+int RodsCollTableModel::rowCount(const QModelIndex &parent) const
+{
+    // table model rows have no children
+    if (parent.isValid())
+        return (0);
+
+    return (this->rows.size());
+}
+
+int RodsCollTableModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return (0);
+
+    return (RodsCollTableModel::numColumns);
+}
+
+QVariant RodsCollTableModel::data(const QModelIndex &index, int role) const
+{
+    // for an invalid index return empty data
+    if (!index.isValid() || index.row() >= (int)this->rows.size())
+        return (QVariant());
+
+    const RodsCollTableModel::Row &row = this->rows.at(index.row());
+
+    if ((role == Qt::DecorationRole) && (index.column() == 0))
+        return (QVariant(this->dataIcon));
+
+    else if (role == Qt::DisplayRole)
+    {
+        switch (index.column())
+        {
+            case 0:
+                return (QVariant(row.name.c_str()));
+
+            case 1:
+                return (QVariant(RodsObjTreeItem::formatSizeString(row.size)));
+
+            case 2:
+                return (QVariant(RodsObjTreeItem::formatDateString(row.createTime).c_str()));
+
+            case 3:
+                return (QVariant(RodsObjTreeItem::formatDateString(row.modifyTime).c_str()));
+
+            case 4:
+                return (QVariant(row.replNum));
+
+            default:
+            break;
+        }
+    }
+
+    // sizes and replica numbers are aligned right
+    else if ((role == Qt::TextAlignmentRole) && (index.column() == 1 || index.column() == 4))
+        return (QVariant(int(Qt::AlignRight | Qt::AlignVCenter)));
+
+    return (QVariant());
+}
+
+QVariant RodsCollTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    // if we have sufficient conditions for giving out header data
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole))
+    {
+        switch (section)
+        {
+            case 0:
+                return (QVariant("Name"));
+
+            case 1:
+                return (QVariant("Size"));
+
+            case 2:
+                return (QVariant("Created"));
+
+            case 3:
+                return (QVariant("Modified"));
+
+            case 4:
+                return (QVariant("Replica"));
+
+            default:
+            break;
+        }
+    }
+
+    // by default, return empty variant object
+    return (QVariant());
+}
+
+bool RodsCollTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return (false);
+
+    return (!this->atEnd);
+}
+
+void RodsCollTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid())
+        return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    this->fetchPage();
+
+    QApplication::restoreOverrideCursor();
+}
+
+void RodsCollTableModel::sort(int column, Qt::SortOrder order)
+{
+    // sanity check for column bounds
+    if (column < 0 || column >= this->columnCount(QModelIndex()))
+        return;
+
+    this->sortColumn = column;
+    this->sortOrder = order;
+
+    this->refresh();
+}
+
+void RodsCollTableModel::setNameFilter(const QString &filter)
+{
+    std::string filterStr = filter.trimmed().toStdString();
+
+    // if the filter didn't change, there is nothing to do
+    if (filterStr == this->nameFilter)
+        return;
+
+    this->nameFilter = filterStr;
+    this->refresh();
+}
+
+void RodsCollTableModel::refresh()
+{
+    // drop all fetched rows, the view will fetch the first page lazily
+    beginResetModel();
+    this->rows.clear();
+    this->atEnd = false;
+    endResetModel();
+}
+
+std::string RodsCollTableModel::collPath() const
+{
+    return (this->path);
+}
+
+std::string RodsCollTableModel::objectPath(const QModelIndex &index) const
+{
+    if (!index.isValid() || index.row() >= (int)this->rows.size())
+        return (std::string());
+
+    std::string objPath = this->path;
+
+    if (objPath.empty() || objPath.at(objPath.length() - 1) != '/')
+        objPath += "/";
+
+    return (objPath + this->rows.at(index.row()).name);
+}
+
+int RodsCollTableModel::querySummary(rodsLong_t *replCount, rodsLong_t *totalSize, rodsLong_t *maxSize) const
+{
+    Kanki::RodsGenQuery query(this->rodsConn);
+    int status = 0;
+
+    *replCount = *totalSize = *maxSize = 0;
+
+    // with only aggregated attributes the server returns a single row
+    query.addQueryAttribute(COL_D_DATA_ID, Kanki::RodsGenQuery::selectCount);
+    query.addQueryAttribute(COL_DATA_SIZE, Kanki::RodsGenQuery::selectSum);
+    query.addQueryAttribute(COL_DATA_SIZE, Kanki::RodsGenQuery::selectMax);
+
+    query.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, this->path);
+
+    if (this->nameFilter.length())
+        query.addQueryCondition(COL_DATA_NAME, Kanki::RodsGenQuery::isLike,
+                                "%" + Kanki::RodsGenQuery::escapeLike(this->nameFilter) + "%");
+
+    if ((status = query.execute()) < 0)
+        return (status);
+
+    const Kanki::RodsQueryResult &result = query.result();
+
+    // columns are in the order of the query attributes
+    if (result.rowCount())
+    {
+        *replCount = result.int64Value(0, 0);
+        *totalSize = result.int64Value(0, 1);
+        *maxSize = result.int64Value(0, 2);
+    }
+
+    return (status);
+}
+
+int RodsCollTableModel::fetchPage()
+{
+    Kanki::RodsGenQuery query(this->rodsConn);
+    int sortAttr = columnAttrs[this->sortColumn];
+    int status = 0;
+
+    // the sort attribute is selected first to make it the primary ordering on the server
+    query.addQueryAttribute(sortAttr, this->sortOrder == Qt::AscendingOrder ?
+                                Kanki::RodsGenQuery::orderAscending : Kanki::RodsGenQuery::orderDescending);
+
+    // object name and replica number as secondary ordering keep the pages stable,
+    // a name sort keeps its own direction
+    if (sortAttr != COL_DATA_NAME)
+        query.addQueryAttribute(COL_DATA_NAME, Kanki::RodsGenQuery::orderAscending);
+
+    if (sortAttr != COL_DATA_REPL_NUM)
+        query.addQueryAttribute(COL_DATA_REPL_NUM, Kanki::RodsGenQuery::orderAscending);
+
+    // the rest of the columns, selecting an attribute again would reset its ordering
+    for (int i = 0; i < this->columnCount(QModelIndex()); i++)
+    {
+        if (columnAttrs[i] != sortAttr && columnAttrs[i] != COL_DATA_NAME && columnAttrs[i] != COL_DATA_REPL_NUM)
+            query.addQueryAttribute(columnAttrs[i]);
+    }
+
+    // restrict to the collection, and push the name filter to the server
+    query.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, this->path);
+
+    if (this->nameFilter.length())
+        query.addQueryCondition(COL_DATA_NAME, Kanki::RodsGenQuery::isLike,
+                                "%" + Kanki::RodsGenQuery::escapeLike(this->nameFilter) + "%");
+
+    // fetch only the next page
+    query.setRowOffset(this->rows.size());
+    query.setRowLimit(pageSize);
+
+    // on error stop fetching more pages
+    if ((status = query.execute()) < 0)
+    {
+        this->atEnd = true;
+        return (status);
+    }
+
+    const Kanki::RodsQueryResult &result = query.result();
+    int nameIndex = result.attributeIndex(COL_DATA_NAME);
+    int sizeIndex = result.attributeIndex(COL_DATA_SIZE);
+    int ctimeIndex = result.attributeIndex(COL_D_CREATE_TIME);
+    int mtimeIndex = result.attributeIndex(COL_D_MODIFY_TIME);
+    int replIndex = result.attributeIndex(COL_DATA_REPL_NUM);
+
+    // a short page is the last one
+    if ((int)result.rowCount() < pageSize)
+        this->atEnd = true;
+
+    if (result.rowCount())
+    {
+        beginInsertRows(QModelIndex(), this->rows.size(), this->rows.size() + result.rowCount() - 1);
+
+        for (size_t i = 0; i < result.rowCount(); i++)
+        {
+            RodsCollTableModel::Row row;
+
+            row.name = result.cstr(i, nameIndex);
+            row.size = result.int64Value(i, sizeIndex);
+            row.createTime = (time_t)result.int64Value(i, ctimeIndex);
+            row.modifyTime = (time_t)result.int64Value(i, mtimeIndex);
+            row.replNum = (int)result.int64Value(i, replIndex);
+
+            this->rows.push_back(row);
+        }
+
+        endInsertRows();
+    }
+
+    return (result.rowCount());
+}
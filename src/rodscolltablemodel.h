@@ -0,0 +1,131 @@
+/**
+ * @file rodscolltablemodel.h
+ * @brief Definition of class RodsCollTableModel
+ *
+ * The class RodsCollTableModel extends the Qt model class QAbstractTableModel
+ * and implements a paged table model for the data objects of an iRODS collection,
+ * with sorting and name filtering executed on the iRODS server.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSCOLLTABLEMODEL_H
+#define RODSCOLLTABLEMODEL_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// ANSI C standard library headers
+#include <cstdlib>
+#include <ctime>
+
+// Qt framework headers
+#include <QApplication>
+#include <QAbstractTableModel>
+#include <QIcon>
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "_rodsgenquery.h"
+
+// application headers
+#include "rodsobjtreeitem.h"
+
+class RodsCollTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor requires a Kanki rods conn pointer and the rods collection path.
+    RodsCollTableModel(Kanki::RodsConnection *conn, const std::string &collPath, QObject *parent = 0);
+
+    // Overrides superclass virtual function for querying the row count of the model.
+    int rowCount(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for querying the column count of the model.
+    int columnCount(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for querying model data with
+    // respect to a model index reference for a given Qt role.
+    QVariant data(const QModelIndex &index, int role) const;
+
+    // Overrides superclass virtual function for querying header data for
+    // view display purposes, for a given section and orientation and Qt role.
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const;
+
+    // Overrides superclass virtual function for querying whether there are
+    // more rows available on the server for lazy loading.
+    bool canFetchMore(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for fetching the next page of rows.
+    void fetchMore(const QModelIndex &parent);
+
+    // Overrides superclass virtual function for sorting the model by a column,
+    // the sorting is done by the server and the model is reloaded from the first page.
+    void sort(int column, Qt::SortOrder order);
+
+    // Interface for accessing the rods collection path of the model.
+    std::string collPath() const;
+
+    // Interface for accessing the full rods path of the object at a model index.
+    std::string objectPath(const QModelIndex &index) const;
+
+    // Queries the replica count, the total size and the largest replica size of the objects
+    // matching the current name filter. The server computes the aggregates in a single query.
+    int querySummary(rodsLong_t *replCount, rodsLong_t *totalSize, rodsLong_t *maxSize) const;
+
+public slots:
+
+    // Qt slot for setting a data object name filter, the server returns only the objects
+    // with names containing the filter string. An empty filter string shows all objects.
+    void setNameFilter(const QString &filter);
+
+    // Qt slot for reloading the model from the first page.
+    void refresh();
+
+private:
+
+    // Class local private data structure for a table row of data object properties.
+    struct Row {
+        std::string name;
+        int replNum;
+        rodsLong_t size;
+        time_t createTime, modifyTime;
+    };
+
+    // executes a query for the next page of rows and appends them to the model
+    int fetchPage();
+
+    // count of rows requested from the server per page
+    static const int pageSize;
+
+    // count of table columns and their rods attributes
+    static const int numColumns;
+    static const int columnAttrs[];
+
+    // rods conn pointer
+    Kanki::RodsConnection *rodsConn;
+
+    // rods collection path and object name filter
+    std::string path, nameFilter;
+
+    // current sort column and order
+    int sortColumn;
+    Qt::SortOrder sortOrder;
+
+    // whether all rows have been fetched from the server
+    bool atEnd;
+
+    // qt icon for data objects
+    QIcon dataIcon;
+
+    // rows fetched so far
+    std::vector<RodsCollTableModel::Row> rows;
+};
+
+#endif // RODSCOLLTABLEMODEL_H
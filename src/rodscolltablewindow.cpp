@@ -0,0 +1,99 @@
+/**
+ * @file rodscolltablewindow.cpp
+ * @brief Implementation of class RodsCollTableWindow
+ *
+ * The RodsCollTableWindow class extends the Qt widget base class QWidget
+ * and implements a sortable and filterable table window for the data objects
+ * of a large iRODS collection.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsCollTableWindow header
+#include "rodscolltablewindow.h"
+
+RodsCollTableWindow::RodsCollTableWindow(Kanki::RodsConnection *rodsConn, const std::string &collPath) :
+    QWidget(NULL)
+{
+    this->path = collPath;
+    this->setWindowTitle(QString("Collection Table - ") + collPath.c_str());
+    this->resize(800, 600);
+
+    this->layout = new QVBoxLayout(this);
+
+    this->filterEdit = new QLineEdit(this);
+    this->filterEdit->setPlaceholderText("Filter by object name (press enter)");
+    this->filterEdit->setClearButtonEnabled(true);
+    this->layout->addWidget(this->filterEdit);
+
+    // the model sorts on the server, the view only passes on the requests
+    this->model = new RodsCollTableModel(rodsConn, collPath);
+
+    this->tableView = new QTableView(this);
+    this->tableView->setModel(this->model);
+    this->tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    this->tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    this->tableView->setSortingEnabled(true);
+    this->tableView->sortByColumn(0, Qt::AscendingOrder);
+    this->tableView->verticalHeader()->hide();
+    this->tableView->horizontalHeader()->setStretchLastSection(true);
+    this->tableView->setColumnWidth(0, 300);
+    this->layout->addWidget(this->tableView);
+
+    this->summaryLabel = new QLabel(this);
+    this->layout->addWidget(this->summaryLabel);
+
+    connect(this->filterEdit, &QLineEdit::returnPressed, this, &RodsCollTableWindow::applyFilter);
+    connect(this->tableView, &QTableView::doubleClicked, this, &RodsCollTableWindow::invokeSelectObj);
+
+    this->updateSummary();
+}
+
+RodsCollTableWindow::~RodsCollTableWindow()
+{
+    delete (this->summaryLabel);
+    delete (this->tableView);
+    delete (this->model);
+    delete (this->filterEdit);
+    delete (this->layout);
+}
+
+void RodsCollTableWindow::closeEvent(QCloseEvent *event)
+{
+    (void)event;
+
+    // signal out unregistering
+    this->unregister(this->path);
+}
+
+void RodsCollTableWindow::applyFilter()
+{
+    this->model->setNameFilter(this->filterEdit->text());
+    this->updateSummary();
+}
+
+void RodsCollTableWindow::invokeSelectObj(const QModelIndex &index)
+{
+    std::string objPath = this->model->objectPath(index);
+
+    if (objPath.length())
+        this->selectObj(QString(objPath.c_str()));
+}
+
+void RodsCollTableWindow::updateSummary()
+{
+    rodsLong_t replCount = 0, totalSize = 0, maxSize = 0;
+
+    if (this->model->querySummary(&replCount, &totalSize, &maxSize) < 0)
+    {
+        this->summaryLabel->setText("Summary not available");
+        return;
+    }
+
+    this->summaryLabel->setText(QString("%1 replicas, total size %2, largest %3").arg(replCount)
+                                .arg(RodsObjTreeItem::formatSizeString(totalSize))
+                                .arg(RodsObjTreeItem::formatSizeString(maxSize)));
+}
@@ -0,0 +1,92 @@
+/**
+ * @file rodscolltablewindow.h
+ * @brief Definition of class RodsCollTableWindow
+ *
+ * The RodsCollTableWindow class extends the Qt widget base class QWidget
+ * and implements a sortable and filterable table window for the data objects
+ * of a large iRODS collection.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSCOLLTABLEWINDOW_H
+#define RODSCOLLTABLEWINDOW_H
+
+// C++ standard library headers
+#include <string>
+
+// Qt framework headers
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QLineEdit>
+#include <QLabel>
+#include <QTableView>
+#include <QHeaderView>
+#include <QCloseEvent>
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+
+// application headers
+#include "rodscolltablemodel.h"
+
+class RodsCollTableWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor initializes the table window for the given rods collection path.
+    explicit RodsCollTableWindow(Kanki::RodsConnection *rodsConn, const std::string &collPath);
+
+    ~RodsCollTableWindow();
+
+signals:
+
+    // Qt signal to unregister the table window for deletion.
+    void unregister(const std::string &collPath);
+
+    // Qt signal for requesting the selection of a rods object in the grid browser.
+    void selectObj(QString objPath);
+
+protected:
+
+    // Qt event handler for the window close event. Invokes the unregister signal.
+    void closeEvent(QCloseEvent *event);
+
+private slots:
+
+    // Qt slot for applying the name filter from the filter line edit.
+    void applyFilter();
+
+    // Qt slot for signaling out the selection of an object at a table index.
+    void invokeSelectObj(const QModelIndex &index);
+
+    // Qt slot for updating the summary label with the aggregates computed by the server.
+    void updateSummary();
+
+private:
+
+    // rods collection path
+    std::string path;
+
+    // Qt UI layout instance
+    QVBoxLayout *layout;
+
+    // Qt line edit for the name filter
+    QLineEdit *filterEdit;
+
+    // Qt table view for the collection
+    QTableView *tableView;
+
+    // Qt label for the collection summary
+    QLabel *summaryLabel;
+
+    // collection table model instance
+    RodsCollTableModel *model;
+};
+
+#endif // RODSCOLLTABLEWINDOW_H
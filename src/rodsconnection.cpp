@@ -35,6 +35,15 @@ RodsConnection::RodsConnection(RodsConnection *connPtr)
     if (connPtr)
     {
         // TODO: copy connection parameters
+
+        // share the query result cache and the name index
+        this->cache = connPtr->cache;
+        this->index = connPtr->index;
+    }
+
+    else {
+        this->cache.reset(new Kanki::RodsQueryCache());
+        this->index.reset(new Kanki::RodsNameIndex());
     }
 }
 
@@ -210,6 +219,21 @@ int RodsConnection::makeColl(const std::string &collPath, bool makeRecursive)
 
     this->mutexUnlock();
 
+    // cached query results of the namespace may be stale
+    if (status >= 0)
+    {
+        this->cache->invalidate(Kanki::RodsQueryCache::namespaceScope);
+
+        // a recursive operation may have made the parent collections too
+        if (makeRecursive)
+        {
+            for (size_t pos = collPath.find('/', 1); pos != std::string::npos; pos = collPath.find('/', pos + 1))
+                this->index->addObject(collPath.substr(0, pos), COLL_OBJ_T);
+        }
+
+        this->index->addObject(collPath, COLL_OBJ_T);
+    }
+
     // return status to caller
     return (status);
 }
@@ -225,6 +249,9 @@ int RodsConnection::readColl(const std::string &collPath, std::vector<RodsObjEnt
     if (!collObjs || collPath.empty())
         return (-1);
 
+    // the caller may append to previously read objects
+    size_t firstObj = collObjs->size();
+
     // take a temp copy of the coll path string
     strcpy(collPathIn, collPath.c_str());
 
@@ -258,6 +285,17 @@ int RodsConnection::readColl(const std::string &collPath, std::vector<RodsObjEnt
 
     this->mutexUnlock();
 
+    // the listing of the collection updates the name index
+    if (status >= 0 && this->index->isEnabled())
+    {
+        if (firstObj)
+            this->index->indexCollection(collPathOut, std::vector<RodsObjEntryPtr>(collObjs->begin() + firstObj,
+                                                                                    collObjs->end()));
+
+        else
+            this->index->indexCollection(collPathOut, *collObjs);
+    }
+
     return (status);
 }
 
@@ -285,6 +323,13 @@ int RodsConnection::removeColl(const std::string &collPath)
 
     this->mutexUnlock();
 
+    // cached query results of the namespace may be stale
+    if (status >= 0)
+    {
+        this->cache->invalidate(Kanki::RodsQueryCache::namespaceScope);
+        this->index->removeObject(collPath);
+    }
+
     // return status to caller
     return (status);
 }
@@ -331,6 +376,13 @@ int RodsConnection::putFile(const std::string &localPath, const std::string &obj
 
     this->mutexUnlock();
 
+    // cached query results of the namespace may be stale
+    if (status >= 0)
+    {
+        this->cache->invalidate(Kanki::RodsQueryCache::namespaceScope);
+        this->index->addObject(objPath, DATA_OBJ_T);
+    }
+
     // return rods api status
     return (status);
 }
@@ -365,6 +417,13 @@ int RodsConnection::removeObj(const std::string &objPath)
 
     this->mutexUnlock();
 
+    // cached query results of the namespace may be stale
+    if (status >= 0)
+    {
+        this->cache->invalidate(Kanki::RodsQueryCache::namespaceScope);
+        this->index->removeObject(objPath);
+    }
+
     // return status to caller
     return (status);
 }
@@ -438,11 +497,18 @@ int RodsConnection::moveObjToColl(RodsObjEntryPtr objEntry, const std::string &c
     // try to execute rods api call (which is named somewhat incorrectly...)
     if ((status = rcDataObjRename(this->rodsCommPtr, &objMoveInp)) >= 0)
     {
+        // a moved collection leaves its subtree unindexed until read again
+        this->index->removeObject(objMoveInp.srcDataObjInp.objPath);
+        this->index->addObject(newObjPath, objEntry->objType);
+
         // on success we update th object entry
         objEntry->collPath = collPath;
 
         if (objEntry->objType == COLL_OBJ_T)
             objEntry->objName = collPath;
+
+        // cached query results of the namespace may be stale
+        this->cache->invalidate(Kanki::RodsQueryCache::namespaceScope);
     }
 
     // return rods api status to caller
@@ -486,6 +552,10 @@ int RodsConnection::renameObj(RodsObjEntryPtr objEntry, const std::string &newNa
     // try to execute rods api call
     if ((status = rcDataObjRename(this->rodsCommPtr, &objRenameInp)) >= 0)
     {
+        // a renamed collection leaves its subtree unindexed until read again
+        this->index->removeObject(objRenameInp.srcDataObjInp.objPath);
+        this->index->addObject(newObjPath, objEntry->objType);
+
         // on success we update object name
         if (objEntry->objType == DATA_OBJ_T)
             objEntry->objName = newName;
@@ -495,11 +565,24 @@ int RodsConnection::renameObj(RodsObjEntryPtr objEntry, const std::string &newNa
         {
             objEntry->collPath = objEntry->objName = newObjPath;
         }
+
+        // cached query results of the namespace may be stale
+        this->cache->invalidate(Kanki::RodsQueryCache::namespaceScope);
     }
 
     return (status);
 }
 
+Kanki::RodsQueryCache* RodsConnection::queryCache() const
+{
+    return (this->cache.get());
+}
+
+Kanki::RodsNameIndex* RodsConnection::nameIndex() const
+{
+    return (this->index.get());
+}
+
 void RodsConnection::mutexLock()
 {
     this->commMutex.lock();
@@ -27,6 +27,7 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/system/error_code.hpp>
+#include <boost/shared_ptr.hpp>
 
 // iRODS client library headers
 #include "rodsClient.h"
@@ -37,6 +38,8 @@
 
 // Kanki iRODS C++ class library headers
 #include "rodsobjentry.h"
+#include "rodsquerycache.h"
+#include "rodsnameindex.h"
 
 namespace Kanki {
 
@@ -46,7 +49,8 @@ class RodsConnection
 public:
 
     // Constructor for instantiating a new connection object, optionally identical with
-    // respect to the parameters of the conn object pointed by argument connPtr.
+    // respect to the parameters of the conn object pointed by argument connPtr. Connections
+    // instantiated from another one share its query result cache and name index.
     RodsConnection(RodsConnection *connPtr = NULL);
 
     // Establishes an iRODS protocol connection to an iRODS server. Also configures the
@@ -102,6 +106,14 @@ public:
     // Interface for querying the last rods api provided error code.
     int lastError() const;
 
+    // Interface for accessing the query result cache of the connection. Operations changing
+    // the catalog through the connection invalidate the affected results.
+    Kanki::RodsQueryCache* queryCache() const;
+
+    // Interface for accessing the local name index of the connection, built from the collections
+    // read and updated by the operations changing the namespace through the connection.
+    Kanki::RodsNameIndex* nameIndex() const;
+
     // Locks the connection specific mutex lock to prevent simultaneous use of the same iRODS
     // connection by two different threads.
     void mutexLock();
@@ -162,6 +174,12 @@ private:
 
     // rods api last error message
     rErrMsg_t lastErrMsg;
+
+    // query result cache, shared between connections instantiated from each other
+    boost::shared_ptr<Kanki::RodsQueryCache> cache;
+
+    // local name index, shared between connections instantiated from each other
+    boost::shared_ptr<Kanki::RodsNameIndex> index;
 };
 
 } // namespace Kanki
@@ -0,0 +1,113 @@
+/**
+ * @file rodsconnectionpool.cpp
+ * @brief Implementation of Kanki library class RodsConnectionPool
+ *
+ * The Kanki class RodsConnectionPool provides a bounded pool of
+ * authenticated iRODS connections for executing operations in parallel.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsConnectionPool header
+#include "rodsconnectionpool.h"
+
+namespace Kanki {
+
+RodsConnectionPool::RodsConnectionPool(Kanki::RodsConnection *theConn, unsigned int maxConns)
+{
+    this->templateConn = theConn;
+
+    // at least one connection is necessary to get anything done
+    this->maxConns = std::max(maxConns, 1U);
+}
+
+RodsConnectionPool::~RodsConnectionPool()
+{
+    this->clear();
+}
+
+Kanki::RodsConnection* RodsConnectionPool::acquire(int *status)
+{
+    boost::unique_lock<boost::mutex> lock(this->poolMutex);
+    Kanki::RodsConnection *conn = NULL;
+
+    *status = 0;
+
+    // wait until there is an idle connection or room for a new one
+    while (this->idleConns.empty() && this->conns.size() >= this->maxConns)
+        this->releaseCond.wait(lock);
+
+    // reuse an idle connection if one is still ready
+    while (!this->idleConns.empty())
+    {
+        conn = this->idleConns.back();
+        this->idleConns.pop_back();
+
+        if (conn->isReady())
+            return (conn);
+
+        // drop connections which have gone stale
+        this->conns.erase(std::find(this->conns.begin(), this->conns.end(), conn));
+        conn->disconnect();
+        delete (conn);
+    }
+
+    // reserve the slot and connect without holding the pool lock
+    conn = new Kanki::RodsConnection(this->templateConn);
+    this->conns.push_back(conn);
+
+    lock.unlock();
+
+    if ((*status = conn->connect()) >= 0 && (*status = conn->login()) >= 0 && conn->isReady())
+        return (conn);
+
+    // on failure, free the slot for others
+    if (*status >= 0)
+        *status = conn->lastError();
+
+    conn->disconnect();
+
+    lock.lock();
+    this->conns.erase(std::find(this->conns.begin(), this->conns.end(), conn));
+    this->releaseCond.notify_one();
+    lock.unlock();
+
+    delete (conn);
+
+    return (NULL);
+}
+
+void RodsConnectionPool::release(Kanki::RodsConnection *conn)
+{
+    boost::unique_lock<boost::mutex> lock(this->poolMutex);
+
+    this->idleConns.push_back(conn);
+    this->releaseCond.notify_one();
+}
+
+unsigned int RodsConnectionPool::maxSize() const
+{
+    return (this->maxConns);
+}
+
+void RodsConnectionPool::clear()
+{
+    boost::unique_lock<boost::mutex> lock(this->poolMutex);
+
+    // connections in use are left alone
+    for (std::vector<Kanki::RodsConnection*>::iterator i = this->idleConns.begin(); i != this->idleConns.end(); i++)
+    {
+        Kanki::RodsConnection *conn = *i;
+
+        this->conns.erase(std::find(this->conns.begin(), this->conns.end(), conn));
+        conn->disconnect();
+        delete (conn);
+    }
+
+    this->idleConns.clear();
+}
+
+} // namespace Kanki
@@ -0,0 +1,78 @@
+/**
+ * @file rodsconnectionpool.h
+ * @brief Definition of Kanki library class RodsConnectionPool
+ *
+ * The Kanki class RodsConnectionPool provides a bounded pool of
+ * authenticated iRODS connections for executing operations in parallel.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSCONNECTIONPOOL_H
+#define RODSCONNECTIONPOOL_H
+
+// C++ standard library headers
+#include <vector>
+#include <algorithm>
+
+// boost library headers
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+
+namespace Kanki {
+
+class RodsConnectionPool
+{
+public:
+
+    // Constructor receives the connection which the pooled connections are modeled after
+    // and the maximum count of pooled connections. Connections are established on demand.
+    RodsConnectionPool(Kanki::RodsConnection *theConn, unsigned int maxConns);
+
+    // Destructor disconnects and frees all the pooled connections, none may be in use.
+    ~RodsConnectionPool();
+
+    // Acquires a ready connection from the pool for exclusive use, connecting a new one if
+    // the pool is not full, otherwise waits for a connection to be released. On failure to
+    // connect returns NULL and the rods api status in status.
+    Kanki::RodsConnection* acquire(int *status);
+
+    // Releases a connection acquired from the pool back for reuse.
+    void release(Kanki::RodsConnection *conn);
+
+    // Returns the maximum count of pooled connections.
+    unsigned int maxSize() const;
+
+    // Disconnects and frees the idle pooled connections.
+    void clear();
+
+private:
+
+    // we deny assignments and copying of the object
+    RodsConnectionPool(const RodsConnectionPool &);
+    RodsConnectionPool& operator=(const RodsConnectionPool &);
+
+    // connection which the pooled connections are modeled after
+    Kanki::RodsConnection *templateConn;
+
+    // maximum count of pooled connections
+    unsigned int maxConns;
+
+    // all connections of the pool and the ones available for use
+    std::vector<Kanki::RodsConnection*> conns, idleConns;
+
+    // mutex and condition for waiting on released connections
+    boost::mutex poolMutex;
+    boost::condition_variable releaseCond;
+};
+
+} // namespace Kanki
+
+#endif // RODSCONNECTIONPOOL_H
@@ -14,6 +14,9 @@
 // application class RodsDownloadThread header
 #include "rodsdownloadthread.h"
 
+// initialize static class constants
+const unsigned int RodsDownloadThread::nameBatchSize = 64;
+
 RodsDownloadThread::RodsDownloadThread(Kanki::RodsConnection *theConn, Kanki::RodsObjEntryPtr theObj,
                                        const std::string &theDestPath, bool verifyChecksum, bool allowOverwrite)
     : QThread()
@@ -26,6 +29,18 @@ RodsDownloadThread::RodsDownloadThread(Kanki::RodsConnection *theConn, Kanki::Ro
     this->overwrite = allowOverwrite;
 }
 
+RodsDownloadThread::RodsDownloadThread(Kanki::RodsConnection *theConn, const Kanki::RodsObjGroups &theObjs,
+                                       const std::string &theDestPath, bool verifyChecksum, bool allowOverwrite)
+    : QThread()
+{
+    this->conn = new Kanki::RodsConnection(theConn);
+    this->objGroups = theObjs;
+    this->destPath = theDestPath;
+
+    this->verify = verifyChecksum;
+    this->overwrite = allowOverwrite;
+}
+
 void RodsDownloadThread::run()
 {
     int status = 0;
@@ -47,8 +62,12 @@ void RodsDownloadThread::run()
         return;
     }
 
+    // in the case of downloading a list of data objects, do it as one job
+    if (!this->objGroups.empty())
+        this->downloadObjGroups();
+
     // in the case of downloading a collection, do it recursively
-    if (this->objEntry->objType == COLL_OBJ_T)
+    else if (this->objEntry->objType == COLL_OBJ_T)
     {
         std::vector<Kanki::RodsObjEntryPtr> collObjs;
         std::string basePath = this->objEntry->collPath;
@@ -164,6 +183,138 @@ int RodsDownloadThread::makeCollObjList(Kanki::RodsObjEntryPtr obj, std::vector<
     return (status);
 }
 
+int RodsDownloadThread::makeGroupObjList(std::vector<Kanki::RodsObjEntryPtr> *objs, rodsLong_t *totalSize)
+{
+    int status = 0;
+
+    for (unsigned int i = 0; i < this->objGroups.size(); i++)
+    {
+        const std::string &collPath = this->objGroups.at(i).first;
+        const std::vector<std::string> &dataNames = this->objGroups.at(i).second;
+        std::vector<std::vector<std::string> > batches =
+                Kanki::RodsGenQuery::makeValueBatches(dataNames, RodsDownloadThread::nameBatchSize);
+        std::map<std::string, size_t> objIndex;
+
+        // the names are queried in batches of an in condition each
+        for (unsigned int j = 0; j < batches.size(); j++)
+        {
+            Kanki::RodsGenQuery query(this->conn);
+
+            query.addQueryAttribute(COL_DATA_NAME);
+            query.addQueryAttribute(COL_D_CREATE_TIME);
+            query.addQueryAttribute(COL_D_MODIFY_TIME);
+            query.addQueryAttribute(COL_DATA_REPL_NUM);
+            query.addQueryAttribute(COL_D_REPL_STATUS);
+            query.addQueryAttribute(COL_DATA_SIZE);
+
+            query.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, collPath);
+            query.addQueryCondition(COL_DATA_NAME, Kanki::RodsGenQuery::isIn, batches.at(j));
+
+            if ((status = query.execute()) < 0)
+                return (status);
+
+            const Kanki::RodsQueryResult &result = query.result();
+
+            for (size_t row = 0; row < result.rowCount(); row++)
+            {
+                Kanki::RodsObjEntryPtr obj(new Kanki::RodsObjEntry(result.cstr(row, 0), collPath,
+                                                                   result.cstr(row, 1), result.cstr(row, 2),
+                                                                   DATA_OBJ_T, (int)result.int64Value(row, 3),
+                                                                   (int)result.int64Value(row, 4),
+                                                                   result.int64Value(row, 5)));
+                std::map<std::string, size_t>::iterator found = objIndex.find(obj->objName);
+
+                // one replica of each object is downloaded, a good one if there is one
+                if (found == objIndex.end())
+                {
+                    objIndex[obj->objName] = objs->size();
+                    objs->push_back(obj);
+                }
+
+                else if (!objs->at(found->second)->replStatus && obj->replStatus)
+                    objs->at(found->second) = obj;
+            }
+
+            // notify ui
+            QString statusStr = "Building a list of objects (" + QVariant((int)objs->size()).toString() + ")...";
+            progressMarquee(statusStr);
+        }
+    }
+
+    for (unsigned int i = 0; i < objs->size(); i++)
+        *totalSize += objs->at(i)->objSize;
+
+    return (status);
+}
+
+void RodsDownloadThread::downloadObjGroups()
+{
+    std::vector<Kanki::RodsObjEntryPtr> objs;
+    std::string basePath = RodsDownloadThread::commonCollPath(this->objGroups);
+    rodsLong_t totalSize = 0, doneSize = 0;
+    int status = 0;
+
+    if ((status = this->makeGroupObjList(&objs, &totalSize)) < 0)
+    {
+        reportError("Download failed", "Querying the data objects failed", status);
+        return;
+    }
+
+    // one progress display for the whole job, by object count
+    setupProgressDisplay("Downloading...", 0, objs.size());
+
+    for (unsigned int i = 0; i < objs.size(); i++)
+    {
+        Kanki::RodsObjEntryPtr curObj = objs.at(i);
+
+        // collections are recreated relative to the common collection
+        std::string dirPath = this->destPath + curObj->collPath.substr(basePath.size());
+        QDir dstDir(dirPath.c_str());
+
+        if (!dstDir.exists())
+            dstDir.mkpath(dirPath.c_str());
+
+        // notify ui of current operation and progress
+        QString statusStr = "Downloading " + QString::fromStdString(curObj->getObjectName());
+        statusStr += " (" + QVariant(i + 1).toString() + " of " + QVariant((int)objs.size()).toString() + ", ";
+        statusStr += QString::number((double)doneSize / 1048576, 'f', 1) + " of ";
+        statusStr += QString::number((double)totalSize / 1048576, 'f', 1) + " MB)";
+        progressUpdate(statusStr, i+1);
+
+        // try to do a rods get operation
+        if ((status = this->downloadFile(curObj, dirPath + "/" + curObj->getObjectName(),
+                                         this->verify, this->overwrite)) < 0)
+            reportError("iRODS get file error", curObj->getObjectFullPath().c_str(), status);
+
+        doneSize += curObj->objSize;
+    }
+}
+
+std::string RodsDownloadThread::commonCollPath(const Kanki::RodsObjGroups &groups)
+{
+    std::string commonPath;
+
+    for (unsigned int i = 0; i < groups.size(); i++)
+    {
+        const std::string &collPath = groups.at(i).first;
+
+        if (!i)
+        {
+            commonPath = collPath;
+            continue;
+        }
+
+        // shorten the common path until it is a collection containing the path
+        while (!commonPath.empty() && (collPath.compare(0, commonPath.size(), commonPath) != 0 ||
+               (collPath.size() > commonPath.size() && collPath.at(commonPath.size()) != '/')))
+        {
+            commonPath = commonPath.substr(0, commonPath.find_last_of('/'));
+        }
+    }
+
+    return (commonPath);
+}
+
 int RodsDownloadThread::downloadFile(Kanki::RodsObjEntryPtr obj, std::string localPath,
                                      bool verifyChecksum, bool allowOverwrite)
 {
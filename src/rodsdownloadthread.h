@@ -16,6 +16,11 @@
 
 // C++ standard library headers
 #include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
 
 // boost library headers
 #include <boost/thread/thread.hpp>
@@ -33,6 +38,7 @@
 #include "rodsconnection.h"
 #include "rodsobjentry.h"
 #include "rodsdatainstream.h"
+#include "_rodsgenquery.h"
 
 class RodsDownloadThread : public QThread
 {
@@ -44,6 +50,11 @@ public:
     RodsDownloadThread(Kanki::RodsConnection *theConn, Kanki::RodsObjEntryPtr theObj, const std::string &theDestPath,
                        bool verifyChecksum = true, bool allowOverwrite = false);
 
+    // Constructor initializes the download worker thread for downloading the given data objects as one job,
+    // the collections are recreated under the destination path relative to their deepest common collection.
+    RodsDownloadThread(Kanki::RodsConnection *theConn, const Kanki::RodsObjGroups &theObjs,
+                       const std::string &theDestPath, bool verifyChecksum = true, bool allowOverwrite = false);
+
 signals:
 
     // Qt signal for initializing a progress bar display, it signals out
@@ -79,6 +90,15 @@ private:
     // Constructs the list of objects to be downloaded in a recursive manner.
     int makeCollObjList(Kanki::RodsObjEntryPtr obj, std::vector<Kanki::RodsObjEntryPtr> *objs);
 
+    // Constructs the list of data objects to be downloaded from the object groups, one replica each.
+    int makeGroupObjList(std::vector<Kanki::RodsObjEntryPtr> *objs, rodsLong_t *totalSize);
+
+    // Downloads the data objects of the object groups with a single aggregated progress display.
+    void downloadObjGroups();
+
+    // Returns the deepest collection containing all the collections of the object groups.
+    static std::string commonCollPath(const Kanki::RodsObjGroups &groups);
+
     // Implements double-buffered rods object download using Kanki::RodsDataInStream
     // and its adaptive rods i/o request size scaling for best resposniveness and
     // connection throughput utilization.
@@ -88,9 +108,15 @@ private:
     // pointer to the rods connection object
     Kanki::RodsConnection *conn;
 
+    // count of data object names queried at a time
+    static const unsigned int nameBatchSize;
+
     // pointer to the rods object entry to be downloaded
     Kanki::RodsObjEntryPtr objEntry;
 
+    // data objects to be downloaded, if not downloading a single object entry
+    Kanki::RodsObjGroups objGroups;
+
     // destination path (local directory) for the download
     std::string destPath;
 
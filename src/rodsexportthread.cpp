@@ -0,0 +1,129 @@
+/**
+ * @file rodsexportthread.cpp
+ * @brief Implementation of class RodsExportThread
+ *
+ * The RodsExportThread class extends the Qt thread management class
+ * QThread and implements a worker thread for exporting a manifest of
+ * iRODS data objects into a local CSV or JSON lines file.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsExportThread header
+#include "rodsexportthread.h"
+
+RodsExportThread::RodsExportThread(Kanki::RodsConnection *theConn, const std::string &theCollPath,
+                                   const std::string &theDestPath, Kanki::RodsObjExport::Format format,
+                                   bool withMetadata)
+    : QThread()
+{
+    this->collPath = theCollPath;
+    this->init(theConn, theDestPath, format, withMetadata);
+}
+
+RodsExportThread::RodsExportThread(Kanki::RodsConnection *theConn, const Kanki::RodsObjGroups &theObjs,
+                                   const std::string &theDestPath, Kanki::RodsObjExport::Format format,
+                                   bool withMetadata)
+    : QThread()
+{
+    this->objGroups = theObjs;
+    this->init(theConn, theDestPath, format, withMetadata);
+}
+
+RodsExportThread::~RodsExportThread()
+{
+    delete (this->exporter);
+    delete (this->metaConn);
+    delete (this->conn);
+}
+
+void RodsExportThread::init(Kanki::RodsConnection *theConn, const std::string &theDestPath,
+                            Kanki::RodsObjExport::Format format, bool withMetadata)
+{
+    this->conn = new Kanki::RodsConnection(theConn);
+    this->destPath = theDestPath;
+
+    // metadata is queried on a second connection while the first one streams the objects
+    this->metaConn = withMetadata ? new Kanki::RodsConnection(theConn) : NULL;
+
+    this->exporter = new Kanki::RodsObjExport(this->conn, &this->destFile, format, this->metaConn);
+    this->exporter->setProgressHandler(boost::bind(&RodsExportThread::exportProgress, this, _1));
+}
+
+void RodsExportThread::cancel()
+{
+    this->exporter->cancel();
+}
+
+void RodsExportThread::run()
+{
+    int status = 0;
+
+    // signal ui to setup progress display
+    progressMarquee("Initializing...");
+
+    // open the parallel connections for the export and authenticate
+    Kanki::RodsConnection *conns[] = { this->conn, this->metaConn };
+
+    for (unsigned int i = 0; i < 2 && conns[i]; i++)
+    {
+        if ((status = conns[i]->connect()) < 0)
+        {
+            reportError("Export failed", "Open parallel connection failed", status);
+            return;
+        }
+
+        else if ((status = conns[i]->login()) < 0)
+        {
+            reportError("Export failed", "Authentication failed", status);
+            return;
+        }
+    }
+
+    this->destFile.open(this->destPath.c_str(), std::ios::out | std::ios::trunc);
+
+    if (!this->destFile.is_open())
+    {
+        reportError("Export failed", QString("Open file failed: ") + this->destPath.c_str(), UNIX_FILE_OPEN_ERR);
+    }
+
+    // a collection subtree is streamed as a whole
+    else if (this->objGroups.empty())
+    {
+        if ((status = this->exporter->exportCollection(this->collPath)) < 0)
+            reportError("Export failed", QString("Query failed for ") + this->collPath.c_str(), status);
+    }
+
+    // data objects are exported collection by collection
+    else {
+        setupProgressDisplay("Exporting...", 0, this->objGroups.size());
+
+        for (unsigned int i = 0; i < this->objGroups.size(); i++)
+        {
+            const std::string &groupColl = this->objGroups.at(i).first;
+
+            if ((status = this->exporter->exportObjects(groupColl, this->objGroups.at(i).second)) < 0)
+            {
+                reportError("Export failed", QString("Query failed for ") + groupColl.c_str(), status);
+                break;
+            }
+
+            progressUpdate(QString("Exporting ") + groupColl.c_str(), i + 1);
+        }
+    }
+
+    this->destFile.close();
+
+    for (unsigned int i = 0; i < 2 && conns[i]; i++)
+        conns[i]->disconnect();
+}
+
+void RodsExportThread::exportProgress(size_t rows)
+{
+    // collection subtrees have no known total
+    if (this->objGroups.empty())
+        progressMarquee("Exported " + QVariant((qulonglong)rows).toString() + " replicas...");
+}
@@ -0,0 +1,106 @@
+/**
+ * @file rodsexportthread.h
+ * @brief Definition of class RodsExportThread
+ *
+ * The RodsExportThread class extends the Qt thread management class
+ * QThread and implements a worker thread for exporting a manifest of
+ * iRODS data objects into a local CSV or JSON lines file.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSEXPORTTHREAD_H
+#define RODSEXPORTTHREAD_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+
+// boost library headers
+#include <boost/bind.hpp>
+
+// Qt framework headers
+#include <QThread>
+#include <QString>
+#include <QVariant>
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsobjentry.h"
+#include "rodsobjexport.h"
+
+class RodsExportThread : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor initializes the export worker thread for exporting the data objects in a
+    // collection subtree into a file, optionally with their metadata.
+    RodsExportThread(Kanki::RodsConnection *theConn, const std::string &theCollPath, const std::string &theDestPath,
+                     Kanki::RodsObjExport::Format format, bool withMetadata = false);
+
+    // Constructor initializes the export worker thread for exporting the given data objects.
+    RodsExportThread(Kanki::RodsConnection *theConn, const Kanki::RodsObjGroups &theObjs,
+                     const std::string &theDestPath, Kanki::RodsObjExport::Format format, bool withMetadata = false);
+
+    // Destructor frees the parallel connections of the thread.
+    ~RodsExportThread();
+
+public slots:
+
+    // Qt slot for cancelling the export, the file is left with the rows exported so far.
+    void cancel();
+
+signals:
+
+    // Qt signal for initializing a progress bar display, it signals out
+    // the initial message text, initial value and maximum value.
+    void setupProgressDisplay(QString text, int value, int maxValue);
+
+    // Qt signal for updating the progress bar display, it signals out
+    // the current message text and current progress value.
+    void progressUpdate(QString text, int progress);
+
+    // Qt signal for setting the progress bar display in marquee mode,
+    // it signals out the current text message.
+    void progressMarquee(QString text);
+
+    // Qt signal for reporting errors to ui, it signals out a message,
+    // an error string and an error code.
+    void reportError(QString msgStr, QString errorStr, int errorCode);
+
+private:
+
+    // initializes the connections and the exporter
+    void init(Kanki::RodsConnection *theConn, const std::string &theDestPath, Kanki::RodsObjExport::Format format,
+              bool withMetadata);
+
+    // Overrides superclass virtual function, executes the export
+    // work in a thread instantiated with the thread object.
+    void run() Q_DECL_OVERRIDE;
+
+    // reports the progress of the export to the ui
+    void exportProgress(size_t rows);
+
+    // pointers to the rods connection objects, for the objects and their metadata
+    Kanki::RodsConnection *conn, *metaConn;
+
+    // collection subtree or the data objects to be exported
+    std::string collPath;
+    Kanki::RodsObjGroups objGroups;
+
+    // destination file of the export
+    std::string destPath;
+    std::ofstream destFile;
+
+    // the exporter writing the file
+    Kanki::RodsObjExport *exporter;
+};
+
+#endif // RODSEXPORTTHREAD_H
@@ -0,0 +1,265 @@
+/**
+ * @file rodsfindresultmodel.cpp
+ * @brief Implementation of class RodsFindResultModel
+ *
+ * The class RodsFindResultModel extends the Qt model class QAbstractItemModel
+ * and implements a streaming model for the results of an iRODS find query,
+ * the data objects found grouped by their collections.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsFindResultModel header
+#include "rodsfindresultmodel.h"
+
+RodsFindResultModel::RodsFindResultModel(QObject *parent)
+    : QAbstractItemModel(parent)
+{
+    std::vector<int> rowAttrs;
+
+    rowAttrs.push_back(COL_DATA_NAME);
+    rowAttrs.push_back(COL_COLL_NAME);
+
+    // staged rows have both names, the model stores only the data object names
+    this->pending.reset(rowAttrs);
+    this->staged.reset(rowAttrs);
+    this->names.reset(std::vector<int>(1, COL_DATA_NAME));
+    this->resultGeneration = 0;
+    this->distinct = false;
+
+    // initialize icons
+    this->dataIcon = QIcon(":/tango/icons/text-x-generic.png");
+    this->collIcon = QIcon(":/tango/icons/folder.png");
+}
+
+QVariant RodsFindResultModel::data(const QModelIndex &index, int role) const
+{
+    // for an invalid index return empty data
+    if (!index.isValid())
+        return (QVariant());
+
+    // top level rows are collections, their children data objects
+    bool isColl = !index.internalId();
+    const RodsFindResultModel::Group &group = this->groups.at(isColl ? index.row() : index.internalId() - 1);
+
+    if (role == Qt::DisplayRole)
+    {
+        if (isColl)
+            return (QString::fromStdString(group.collName));
+
+        boost::string_ref name = this->names.value(group.rows.at(index.row()), 0);
+
+        return (QString::fromUtf8(name.data(), name.size()));
+    }
+
+    else if (role == Qt::DecorationRole)
+        return (isColl ? this->collIcon : this->dataIcon);
+
+    return (QVariant());
+}
+
+QVariant RodsFindResultModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (section == 0 && orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return (QVariant("iRODS Object Path"));
+
+    return (QVariant());
+}
+
+QModelIndex RodsFindResultModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (!this->hasIndex(row, column, parent))
+        return (QModelIndex());
+
+    // the internal id of a data object row is the row of its collection plus one
+    if (!parent.isValid())
+        return (this->createIndex(row, column, (quintptr)0));
+
+    return (this->createIndex(row, column, (quintptr)(parent.row() + 1)));
+}
+
+QModelIndex RodsFindResultModel::parent(const QModelIndex &child) const
+{
+    // collections are at the top level
+    if (!child.isValid() || !child.internalId())
+        return (QModelIndex());
+
+    return (this->createIndex(child.internalId() - 1, 0, (quintptr)0));
+}
+
+int RodsFindResultModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return (0);
+
+    if (!parent.isValid())
+        return (this->groups.size());
+
+    // data objects have no children
+    if (parent.internalId())
+        return (0);
+
+    return (this->groups.at(parent.row()).rows.size());
+}
+
+int RodsFindResultModel::columnCount(const QModelIndex &parent) const
+{
+    (void)parent;
+
+    return (1);
+}
+
+bool RodsFindResultModel::receivePage(unsigned int generation, const Kanki::RodsGenQuery::Page &page)
+{
+    boost::unique_lock<boost::mutex> lock(this->pendingMutex);
+
+    // a superseded search stops at the next page
+    if (generation != this->resultGeneration)
+        return (false);
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        this->pending.append(0, page.valueForAttr(i, COL_DATA_NAME));
+        this->pending.append(1, page.valueForAttr(i, COL_COLL_NAME));
+    }
+
+    // always continue to the next page
+    return (true);
+}
+
+unsigned int RodsFindResultModel::generation() const
+{
+    boost::unique_lock<boost::mutex> lock(this->pendingMutex);
+
+    return (this->resultGeneration);
+}
+
+void RodsFindResultModel::addLocalResults(const std::vector<Kanki::RodsNameIndex::Entry> &objs)
+{
+    boost::unique_lock<boost::mutex> lock(this->pendingMutex);
+
+    // the server rows of the same objects are dropped against the local ones
+    this->distinct = true;
+
+    for (unsigned int i = 0; i < objs.size(); i++)
+    {
+        const std::string &objPath = objs.at(i).path;
+        size_t pos = objPath.find_last_of('/');
+
+        this->pending.append(0, objPath.c_str() + pos + 1);
+        this->pending.append(1, objPath.substr(0, pos).c_str());
+    }
+}
+
+void RodsFindResultModel::flushPending()
+{
+    // take the pending rows, the worker threads continue with the storage of the last flush
+    {
+        boost::unique_lock<boost::mutex> lock(this->pendingMutex);
+        this->staged.swap(this->pending);
+    }
+
+    if (!this->staged.rowCount())
+        return;
+
+    size_t numGroups = this->groups.size();
+    std::vector<RodsFindResultModel::Group> newGroups;
+    std::map<int, std::vector<size_t> > newRows;
+
+    // group the staged rows by collection, into new collections or the existing ones
+    for (size_t i = 0; i < this->staged.rowCount(); i++)
+    {
+        boost::string_ref coll = this->staged.value(i, 1);
+        std::string collName(coll.data(), coll.size());
+        size_t nameRow = this->names.rowCount();
+
+        // the same data object found by another query is there already
+        if (this->distinct && !this->objPaths.insert(collName + "/" + this->staged.cstr(i, 0)).second)
+            continue;
+
+        boost::unordered_map<std::string, int>::iterator groupIter = this->groupIndex.find(collName);
+
+        this->names.append(0, this->staged.cstr(i, 0));
+
+        if (groupIter == this->groupIndex.end())
+        {
+            this->groupIndex[collName] = numGroups + newGroups.size();
+
+            RodsFindResultModel::Group group;
+            group.collName = collName;
+            group.rows.push_back(nameRow);
+            newGroups.push_back(group);
+        }
+
+        else if ((size_t)groupIter->second >= numGroups)
+            newGroups.at(groupIter->second - numGroups).rows.push_back(nameRow);
+
+        else
+            newRows[groupIter->second].push_back(nameRow);
+    }
+
+    this->staged.clear();
+
+    // data objects of the existing collections are inserted as children
+    for (std::map<int, std::vector<size_t> >::iterator i = newRows.begin(); i != newRows.end(); i++)
+    {
+        std::vector<size_t> &rows = this->groups.at(i->first).rows;
+
+        this->beginInsertRows(this->index(i->first, 0, QModelIndex()), rows.size(), rows.size() + i->second.size() - 1);
+        rows.insert(rows.end(), i->second.begin(), i->second.end());
+        this->endInsertRows();
+    }
+
+    // new collections are inserted at the top level with their data objects
+    if (!newGroups.empty())
+    {
+        this->beginInsertRows(QModelIndex(), numGroups, numGroups + newGroups.size() - 1);
+        this->groups.insert(this->groups.end(), newGroups.begin(), newGroups.end());
+        this->endInsertRows();
+    }
+}
+
+void RodsFindResultModel::clear()
+{
+    {
+        boost::unique_lock<boost::mutex> lock(this->pendingMutex);
+        this->pending.clear();
+        this->resultGeneration++;
+    }
+
+    this->beginResetModel();
+
+    this->names.clear();
+    this->groups.clear();
+    this->groupIndex.clear();
+    this->objPaths.clear();
+    this->distinct = false;
+
+    this->endResetModel();
+}
+
+void RodsFindResultModel::setDistinct(bool enabled)
+{
+    this->distinct = enabled;
+}
+
+size_t RodsFindResultModel::resultCount() const
+{
+    return (this->names.rowCount());
+}
+
+std::string RodsFindResultModel::objectPath(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return (std::string());
+
+    if (!index.internalId())
+        return (this->groups.at(index.row()).collName);
+
+    const RodsFindResultModel::Group &group = this->groups.at(index.internalId() - 1);
+
+    return (group.collName + "/" + this->names.cstr(group.rows.at(index.row()), 0));
+}
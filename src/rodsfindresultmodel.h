@@ -0,0 +1,135 @@
+/**
+ * @file rodsfindresultmodel.h
+ * @brief Definition of class RodsFindResultModel
+ *
+ * The class RodsFindResultModel extends the Qt model class QAbstractItemModel
+ * and implements a streaming model for the results of an iRODS find query,
+ * the data objects found grouped by their collections.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSFINDRESULTMODEL_H
+#define RODSFINDRESULTMODEL_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <map>
+
+// boost library headers
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// Qt framework headers
+#include <QAbstractItemModel>
+#include <QIcon>
+
+// Kanki iRODS C++ class library headers
+#include "rodsqueryresult.h"
+#include "rodsnameindex.h"
+#include "_rodsgenquery.h"
+
+class RodsFindResultModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor initializes an empty model.
+    RodsFindResultModel(QObject *parent = 0);
+
+    // Overrides superclass virtual function for querying model data with
+    // respect to a model index reference for a given Qt role.
+    QVariant data(const QModelIndex &index, int role) const;
+
+    // Overrides superclass virtual function for querying header data for
+    // view display purposes, for a given section and orientation and Qt role.
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const;
+
+    // Overrides superclass virtual function for generating a Qt model index for
+    // an item at a given row and column with respect to a parent index.
+    QModelIndex index(int row, int column, const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for accessing a Qt model index for
+    // the parent of a given child item index.
+    QModelIndex parent(const QModelIndex &child) const;
+
+    // Overrides superclass virtual function for querying the row count of the model
+    // at a given parent object index.
+    int rowCount(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for querying the column count of the model
+    // at a given parent object index.
+    int columnCount(const QModelIndex &parent) const;
+
+    // Receives a page of search results with data object name and collection name attributes.
+    // Thread safe, called from the query worker threads. The rows are staged until the next flush,
+    // pages of a search started before the model was last cleared are dropped.
+    bool receivePage(unsigned int generation, const Kanki::RodsGenQuery::Page &page);
+
+    // Returns the generation of the model, a search feeds the model of its starting generation.
+    unsigned int generation() const;
+
+    // Stages data objects found locally, such as from the local name index, and makes the model
+    // distinct: the server may find the same objects again, they are dropped at the flush.
+    void addLocalResults(const std::vector<Kanki::RodsNameIndex::Entry> &objs);
+
+    // Sets whether data objects already in the model are dropped from the staged rows, for the
+    // results of overlapping queries. Set before the results of a search are received, clearing
+    // the model turns it off.
+    void setDistinct(bool enabled);
+
+    // Returns the count of data objects in the model, not including the staged rows.
+    size_t resultCount() const;
+
+    // Interface for accessing the full rods path of the object at a model index.
+    std::string objectPath(const QModelIndex &index) const;
+
+public slots:
+
+    // Qt slot for moving the staged rows into the model, grouped by their collections.
+    void flushPending();
+
+    // Qt slot for clearing the model and the staged rows, starts a new generation.
+    void clear();
+
+private:
+
+    // Class local private data structure for a collection and its data objects, as row
+    // indices into the data object name storage.
+    struct Group {
+        std::string collName;
+        std::vector<size_t> rows;
+    };
+
+    // qt icons for data objects and collections
+    QIcon dataIcon, collIcon;
+
+    // rows received from the worker threads and the generation, protected by the mutex
+    Kanki::RodsQueryResult pending;
+    unsigned int resultGeneration;
+    mutable boost::mutex pendingMutex;
+
+    // rows being moved into the model, swapped with the pending rows
+    Kanki::RodsQueryResult staged;
+
+    // data object names of the model
+    Kanki::RodsQueryResult names;
+
+    // collection groups in the order of appearance, and their indices by collection name
+    std::vector<RodsFindResultModel::Group> groups;
+    boost::unordered_map<std::string, int> groupIndex;
+
+    // whether duplicates are dropped, and the full paths of the data objects in the model
+    // when they are
+    bool distinct;
+    boost::unordered_set<std::string> objPaths;
+};
+
+#endif // RODSFINDRESULTMODEL_H
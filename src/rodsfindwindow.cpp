@@ -17,18 +17,31 @@
 // generated UI class Ui::RodsFindWindow header
 #include "ui_rodsfindwindow.h"
 
+// initialize static class constants
+const unsigned int RodsFindWindow::searchConns = 4;
+const int RodsFindWindow::quickSearchDelay = 300;
+const int RodsFindWindow::quickSearchMinLength = 3;
+const unsigned int RodsFindWindow::facetValueLimit = 20;
+
 RodsFindWindow::RodsFindWindow(Kanki::RodsConnection *rodsConn, QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::RodsFindWindow)
 {
     this->conn = rodsConn;
+    this->connPool = new Kanki::RodsConnectionPool(rodsConn, RodsFindWindow::searchConns);
+    this->searchQuery = NULL;
+    this->searchPartitioned = false;
+    this->condGroup = 0;
+    this->avuIndex = new Kanki::RodsAVUIndex(rodsConn);
+    this->metaFacets = new Kanki::RodsMetadataFacets(rodsConn);
     this->schema = new RodsMetadataSchema();
 
     this->ui->setupUi(this);
     this->ui->criteriaLayout->setAlignment(Qt::AlignTop);
 
-    this->dataIcon = QIcon(":/tango/icons/text-x-generic.png");
-    this->collIcon = QIcon(":/tango/icons/folder.png");
+    // search results are shown as they arrive
+    this->resultModel = new RodsFindResultModel(this);
+    this->ui->treeView->setModel(this->resultModel);
 
     // setup combo box for condition selection
     this->ui->condSel->addItem("Data Object Name", RodsFindWindow::DataObjName);
@@ -43,14 +56,43 @@ RodsFindWindow::RodsFindWindow(Kanki::RodsConnection *rodsConn, QWidget *parent)
 
     // connect ui event signals to handler slots
     connect(this->ui->condAdd, &QPushButton::clicked, this, &RodsFindWindow::addCondition);
+    connect(this->ui->orButton, &QPushButton::clicked, this, &RodsFindWindow::addConditionGroup);
     connect(this->ui->resetButton, &QPushButton::clicked, this, &RodsFindWindow::resetConditions);
     connect(this->ui->executeButton, &QPushButton::clicked, this, &RodsFindWindow::executeSearch);
-    connect(this->ui->treeWidget, &QTreeWidget::doubleClicked, this, &RodsFindWindow::resultDoubleClicked);
+    connect(this->ui->treeView, &QTreeView::doubleClicked, this, &RodsFindWindow::resultDoubleClicked);
+    connect(this->ui->facetIndexButton, &QPushButton::clicked, this, &RodsFindWindow::indexMetadata);
+    connect(this->ui->exportButton, &QPushButton::clicked, this, &RodsFindWindow::exportResults);
+    connect(this->ui->downloadButton, &QPushButton::clicked, this, &RodsFindWindow::downloadResults);
+    connect(this->ui->facetTree, &QTreeWidget::itemChanged, this, &RodsFindWindow::facetItemChanged);
+
+    // search progress is followed while a search is being executed
+    this->progressTimer = new QTimer(this);
+    this->progressTimer->setInterval(100);
+    connect(this->progressTimer, &QTimer::timeout, this, &RodsFindWindow::updateSearchProgress);
+
+    // quick search is executed when the search text hasn't been edited for a while
+    this->quickSearchTimer = new QTimer(this);
+    this->quickSearchTimer->setSingleShot(true);
+    this->quickSearchTimer->setInterval(RodsFindWindow::quickSearchDelay);
+    connect(this->quickSearchTimer, &QTimer::timeout, this, &RodsFindWindow::executeQuickSearch);
+    connect(this->ui->quickSearch, &QLineEdit::textEdited, this, &RodsFindWindow::quickSearchEdited);
+    connect(this->ui->quickSearch, &QLineEdit::returnPressed, this, &RodsFindWindow::executeQuickSearch);
 }
 
 RodsFindWindow::~RodsFindWindow()
 {
+    // searches being executed are cancelled, the queries are closed on the server
+    this->retireSearch();
+
+    for (unsigned int i = 0; i < this->retiredExecs.size(); i++)
+        this->retiredExecs.at(i)->wait();
+
+    this->reapSearches();
+
     this->resetConditions();
+    delete (this->metaFacets);
+    delete (this->avuIndex);
+    delete (this->connPool);
     delete (this->ui);
 }
 
@@ -88,9 +130,8 @@ void RodsFindWindow::addCondition()
         break;
 
         case RodsFindWindow::DataObjMetadata:
-            if (this->attrMap.empty())
-                this->refreshMetadataAttrs();
-            widget = new RodsMetadataConditionWidget(DATA_OBJ_T, this->attrMap);
+            widget = new RodsMetadataConditionWidget(DATA_OBJ_T, this->metadataAttributes(DATA_OBJ_T),
+                                                     this->metaFacets, this->schema);
         break;
 
         case RodsFindWindow::CollName:
@@ -106,9 +147,8 @@ void RodsFindWindow::addCondition()
         break;
 
         case RodsFindWindow::CollMetadata:
-            if (this->attrMap.empty())
-                this->refreshMetadataAttrs();
-            widget = new RodsMetadataConditionWidget(COLL_OBJ_T, this->attrMap);
+            widget = new RodsMetadataConditionWidget(COLL_OBJ_T, this->metadataAttributes(COLL_OBJ_T),
+                                                     this->metaFacets, this->schema);
         break;
 
         default:
@@ -129,100 +169,563 @@ void RodsFindWindow::addCondition()
 
         this->ui->criteriaLayout->addWidget(widget);
         this->condWidgets.push_back(widget);
+
+        // the condition belongs to the group being added
+        this->condGroups[widget] = this->condGroup;
+        this->ui->orButton->setDisabled(false);
     }
 }
 
+void RodsFindWindow::addConditionGroup()
+{
+    // an empty group has no alternative
+    if (!this->groupHasConditions(this->condGroup))
+        return;
+
+    this->condGroup++;
+
+    // the groups are separated by a label
+    QLabel *label = new QLabel("<b>OR</b>");
+    label->setAlignment(Qt::AlignCenter);
+
+    this->ui->criteriaLayout->addWidget(label);
+    this->groupLabels[this->condGroup] = label;
+    this->ui->orButton->setDisabled(true);
+}
+
+bool RodsFindWindow::groupHasConditions(unsigned int group) const
+{
+    for (std::map<RodsConditionWidget*, unsigned int>::const_iterator i = this->condGroups.begin();
+         i != this->condGroups.end(); i++)
+    {
+        if (i->second == group)
+            return (true);
+    }
+
+    return (false);
+}
+
 void RodsFindWindow::executeSearch()
 {
-    int status = 0;
-    Kanki::RodsGenQuery query(this->conn);
-    query.addQueryAttribute(COL_DATA_NAME);
-    query.addQueryAttribute(COL_COLL_NAME);
+    // while a search is being executed, the execute button cancels it
+    if (this->searchExec)
+    {
+        this->searchExec->cancel();
+        this->statusBar()->showMessage("Cancelling search...");
 
-    // evaluate genquery conditions from the condition widgets
-    for (std::vector<RodsConditionWidget*>::iterator i = this->condWidgets.begin();
-         i != this->condWidgets.end(); i++)
+        return;
+    }
+
+    if (!this->conn->isReady())
+        return;
+
+    this->quickSearchTimer->stop();
+
+    this->searchQuery = this->makeSearchQuery();
+    this->searchStart = std::chrono::high_resolution_clock::now();
+    this->resultModel->clear();
+    this->startSearch(true);
+}
+
+void RodsFindWindow::quickSearchEdited(const QString &text)
+{
+    (void)text;
+
+    // every edit restarts the delay
+    this->quickSearchTimer->start();
+}
+
+void RodsFindWindow::executeQuickSearch()
+{
+    QString text = this->ui->quickSearch->text().trimmed();
+
+    // executed right away when return is pressed
+    this->quickSearchTimer->stop();
+
+    // a new search supersedes the one being executed
+    this->retireSearch();
+    this->resultModel->clear();
+
+    if (text.length() < RodsFindWindow::quickSearchMinLength)
     {
-        RodsConditionWidget *widget = *i;
-        widget->evaluateConds(&query);
+        this->statusBar()->clearMessage();
+        this->ui->executeButton->setText("Execute");
+        this->ui->executeButton->setDisabled(this->condWidgets.empty());
+        this->ui->resetButton->setDisabled(this->condWidgets.empty());
+
+        return;
     }
 
-    if (this->conn->isReady())
+    if (!this->conn->isReady())
+        return;
+
+    this->searchStart = std::chrono::high_resolution_clock::now();
+
+    // names in the locally indexed collections are found right away, the server results are merged
+    // in without duplicates and include the objects the index hasn't seen
+    if (this->condWidgets.empty() && this->conn->nameIndex()->isEnabled())
+    {
+        std::vector<Kanki::RodsNameIndex::Entry> objs = this->conn->nameIndex()->search(text.toStdString(), DATA_OBJ_T);
+
+        this->resultModel->addLocalResults(objs);
+        this->resultModel->flushPending();
+    }
+
+    this->searchQuery = this->makeSearchQuery();
+    this->startSearch(true);
+}
+
+Kanki::RodsGenQuery* RodsFindWindow::makeSearchQuery()
+{
+    Kanki::RodsGenQuery *query = new Kanki::RodsGenQuery(this->conn);
+    QString text = this->ui->quickSearch->text().trimmed();
+
+    query->addQueryAttribute(COL_DATA_NAME);
+    query->addQueryAttribute(COL_COLL_NAME);
+
+    // the search text matches anywhere in the data object name, literally as in the local name index
+    if (text.length() >= RodsFindWindow::quickSearchMinLength)
+        query->addQueryCondition(COL_DATA_NAME, Kanki::RodsGenQuery::isLike,
+                                 "%" + Kanki::RodsGenQuery::escapeLike(text.toStdString()) + "%");
+
+    std::set<unsigned int> groups;
+
+    for (std::map<RodsConditionWidget*, unsigned int>::iterator i = this->condGroups.begin();
+         i != this->condGroups.end(); i++)
+        groups.insert(i->second);
+
+    this->searchGroups.clear();
+
+    // evaluate genquery conditions from the condition widgets
+    if (groups.size() <= 1)
     {
-        // execute a timed query
-        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
-        status = query.execute();
-        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        for (std::vector<RodsConditionWidget*>::iterator i = this->condWidgets.begin();
+             i != this->condWidgets.end(); i++)
+        {
+            RodsConditionWidget *widget = *i;
+            widget->evaluateConds(query);
+        }
+    }
 
-        // report errors
-        if (status < 0)
+    // alternative groups of conditions are executed as partitions of the query
+    else {
+        for (std::set<unsigned int>::iterator i = groups.begin(); i != groups.end(); i++)
         {
+            Kanki::RodsGenQuery groupQuery(this->conn);
+            Kanki::RodsGenQuery::Partition part;
 
+            for (std::vector<RodsConditionWidget*>::iterator j = this->condWidgets.begin();
+                 j != this->condWidgets.end(); j++)
+            {
+                if (this->condGroups[*j] == *i)
+                    (*j)->evaluateConds(&groupQuery);
+            }
+
+            part.addConditions(groupQuery);
+            this->searchGroups.push_back(part);
         }
+    }
 
-        // when successful, report results
-        else {
-            this->ui->treeWidget->clear();
+    return (query);
+}
 
-            std::vector<std::string> names = query.getResultSetForAttr(COL_DATA_NAME);
-            std::vector<std::string> colls = query.getResultSetForAttr(COL_COLL_NAME);
-            std::chrono::milliseconds diff = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-            std::map<std::string, QTreeWidgetItem*> collMap;
+std::vector<Kanki::RodsGenQuery::Partition> RodsFindWindow::searchPartitions()
+{
+    Kanki::RodsGenQuery rangeQuery(this->conn);
 
-            QString statusMsg = "Search query successful: " + QVariant((int)names.size()).toString();
-            statusMsg += " results (execution time " + QVariant(((double)diff.count() / (double)1000)).toString() + " sec).";
-            this->statusBar()->showMessage(statusMsg);
+    // the id range of all data objects is a cheap aggregate query for the catalog
+    rangeQuery.addQueryAttribute(COL_D_DATA_ID, Kanki::RodsGenQuery::selectMin);
+    rangeQuery.addQueryAttribute(COL_D_DATA_ID, Kanki::RodsGenQuery::selectMax);
 
-            for (unsigned int i = 0; i < names.size() && i < colls.size(); i++)
-            {
-                QTreeWidgetItem *collItem = NULL;
+    // the range is good enough for a while, quick searches don't requery it
+    rangeQuery.setCacheTTL(60);
 
-                if (collMap.find(colls.at(i)) == collMap.end())
-                {
-                    collItem = collMap[colls.at(i)] = new QTreeWidgetItem(this->ui->treeWidget);
-                    collItem->setText(0, colls.at(i).c_str());
-                    collItem->setIcon(0, this->collIcon);
+    if (rangeQuery.execute() < 0 || !rangeQuery.result().rowCount())
+        return (std::vector<Kanki::RodsGenQuery::Partition>());
 
-                    this->ui->treeWidget->addTopLevelItem(collItem);
-                }
+    // the partitions are disjoint ranges of data object ids
+    return (Kanki::RodsGenQuery::rangePartitions(COL_D_DATA_ID, rangeQuery.result().int64Value(0, 0),
+                                                 rangeQuery.result().int64Value(0, 1), RodsFindWindow::searchConns));
+}
+
+void RodsFindWindow::startSearch(bool partitioned)
+{
+    std::vector<Kanki::RodsGenQuery::Partition> partitions;
 
-                else
-                    collItem = collMap[colls.at(i)];
+    if (partitioned)
+        partitions = this->searchPartitions();
 
-                QTreeWidgetItem *item = new QTreeWidgetItem(collItem);
-                item->setText(0, names.at(i).c_str());
-                item->setIcon(0, this->dataIcon);
+    this->searchPartitioned = partitions.size() > 1;
 
-                collItem->addChild(item);
-            }
+    // alternative condition groups are executed concurrently, each within each id range
+    if (!this->searchGroups.empty())
+    {
+        if (this->searchPartitioned)
+            partitions = Kanki::RodsGenQuery::combinePartitions(this->searchGroups, partitions);
+
+        else
+            partitions = this->searchGroups;
+    }
+
+    else if (!this->searchPartitioned)
+        partitions.clear();
+
+    // an object matching several groups is found by each of them
+    if (!this->searchGroups.empty())
+        this->resultModel->setDistinct(true);
+
+    // the results feed the current generation of the model until it is cleared
+    Kanki::RodsGenQuery::PageHandler pageHandler = boost::bind(&RodsFindResultModel::receivePage, this->resultModel,
+                                                               this->resultModel->generation(), _1);
+
+    // without partitions, the search is executed sequentially on the window connection
+    if (!partitions.empty())
+        this->searchExec = this->searchQuery->executeAsync(this->connPool, partitions, pageHandler);
 
-            this->ui->treeWidget->expandAll();
+    else
+        this->searchExec = this->searchQuery->executeAsync(pageHandler);
+
+    this->statusBar()->showMessage("Searching...");
+    this->progressTimer->start();
+
+    this->ui->executeButton->setText("Cancel");
+    this->ui->executeButton->setDisabled(false);
+    this->ui->resetButton->setDisabled(true);
+}
+
+void RodsFindWindow::updateSearchProgress()
+{
+    this->reapSearches();
+
+    // the timer runs until the retired searches have been freed too
+    if (!this->searchExec)
+    {
+        if (this->retiredExecs.empty())
+            this->progressTimer->stop();
+
+        return;
+    }
+
+    // show the results received so far
+    this->resultModel->flushPending();
+
+    // report progress while the search is being executed
+    if (!this->searchExec->isFinished())
+    {
+        if (!this->searchExec->isCancelled())
+        {
+            QString statusMsg = "Searching... " + QVariant((int)this->searchExec->rowCount()).toString();
+            statusMsg += " results in " + QVariant(this->searchExec->pageCount()).toString() + " pages.";
+            this->statusBar()->showMessage(statusMsg);
         }
+
+        return;
     }
+
+    this->finishSearch();
 }
 
-void RodsFindWindow::resetConditions()
+void RodsFindWindow::finishSearch()
 {
-    this->unregisterCondWidget(NULL);
+    int status = this->searchExec->wait();
+    bool cancelled = this->searchExec->isCancelled();
+
+    this->searchExec.reset();
+
+    // fall back to execution without id ranges if partitioning failed
+    if (status < 0 && this->searchPartitioned && !cancelled)
+    {
+        this->resultModel->clear();
+        this->startSearch(false);
+        return;
+    }
+
+    // show the rest of the results
+    this->resultModel->flushPending();
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    // report errors
+    if (status < 0)
+    {
+        this->statusBar()->showMessage("Search query failed: " + QVariant(status).toString());
+    }
+
+    // when successful (or cancelled), report results
+    else {
+        std::chrono::milliseconds diff = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - this->searchStart);
+
+        QString statusMsg = cancelled ? "Search query cancelled: " : "Search query successful: ";
+        statusMsg += QVariant((int)this->resultModel->resultCount()).toString();
+        statusMsg += " results (execution time " + QVariant(((double)diff.count() / (double)1000)).toString() + " sec).";
+        this->statusBar()->showMessage(statusMsg);
+    }
+
+    delete (this->searchQuery);
+    this->searchQuery = NULL;
+
+    this->ui->executeButton->setText("Execute");
+    this->ui->executeButton->setDisabled(this->condWidgets.empty());
+    this->ui->resetButton->setDisabled(this->condWidgets.empty());
 }
 
-void RodsFindWindow::refreshMetadataAttrs()
+void RodsFindWindow::retireSearch()
 {
+    if (!this->searchExec)
+        return;
+
+    // the execution stops at its next page, the query must live until then
+    this->searchExec->cancel();
+
+    this->retiredExecs.push_back(this->searchExec);
+    this->retiredQueries.push_back(this->searchQuery);
+
+    this->searchExec.reset();
+    this->searchQuery = NULL;
+}
+
+void RodsFindWindow::reapSearches()
+{
+    for (unsigned int i = 0; i < this->retiredExecs.size();)
+    {
+        if (this->retiredExecs.at(i)->isFinished())
+        {
+            // releasing the handle joins the finished worker thread
+            this->retiredExecs.erase(this->retiredExecs.begin() + i);
+
+            delete (this->retiredQueries.at(i));
+            this->retiredQueries.erase(this->retiredQueries.begin() + i);
+        }
+
+        else
+            i++;
+    }
+}
+
+void RodsFindWindow::indexMetadata()
+{
+    bool ok = false;
     int status = 0;
-    Kanki::RodsGenQuery query(this->conn);
-    query.addQueryAttribute(COL_META_DATA_ATTR_NAME);
+    std::string collPath = this->avuIndex->collPath().empty() ? this->conn->rodsHome() : this->avuIndex->collPath();
+
+    // make dialog for prompting user
+    QString path = QInputDialog::getText(this, "Index Metadata", "iRODS collection path:",
+                                         QLineEdit::Normal, QString::fromStdString(collPath), &ok);
+
+    if (!ok || path.isEmpty() || !this->conn->isReady())
+        return;
+
+    // indexing is done on the window connection
+    this->retireSearch();
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    this->statusBar()->showMessage("Indexing metadata...");
+    QApplication::processEvents();
+
+    // the indexed subtree is refreshed by the metadata modified since, another one is loaded
+    if (path.toStdString() == this->avuIndex->collPath())
+        status = this->avuIndex->refresh();
 
-    if ((status = query.execute()) < 0)
+    else {
+        this->facetChecks.clear();
+        status = this->avuIndex->load(path.toStdString());
+    }
+
+    QApplication::restoreOverrideCursor();
+
+    this->refreshFacets();
+    this->showFacetResults();
+
+    if (status < 0)
+        this->statusBar()->showMessage("Metadata indexing failed: " + QVariant(status).toString());
+
+    else if (this->facetChecks.empty())
     {
-        // report error
+        QString statusMsg = "Indexed metadata of " + QVariant((int)this->avuIndex->objectCount()).toString();
+        statusMsg += " data objects in " + path + ".";
+        this->statusBar()->showMessage(statusMsg);
     }
+}
+
+void RodsFindWindow::facetItemChanged(QTreeWidgetItem *item, int column)
+{
+    (void)column;
+
+    // only the values under the attributes are checkable
+    if (!item->parent())
+        return;
+
+    std::string attr = item->parent()->data(0, Qt::UserRole).toString().toStdString();
+    std::string value = item->data(0, Qt::UserRole).toString().toStdString();
+
+    if (item->checkState(0) == Qt::Checked)
+        this->facetChecks[attr].insert(value);
 
     else {
-        std::vector<std::string> attrNames = query.getResultSet(0);
+        this->facetChecks[attr].erase(value);
+
+        if (this->facetChecks[attr].empty())
+            this->facetChecks.erase(attr);
+    }
+
+    this->showFacetResults();
+
+    // the item can't be deleted from within its own change signal
+    QTimer::singleShot(0, this, &RodsFindWindow::refreshFacets);
+}
+
+std::vector<Kanki::RodsAVUIndex::AnyOf> RodsFindWindow::facetFilters(const std::string &exceptAttr) const
+{
+    std::vector<Kanki::RodsAVUIndex::AnyOf> filters;
+
+    // any of the checked values of an attribute, and all of the attributes
+    for (std::map<std::string, std::set<std::string> >::const_iterator i = this->facetChecks.begin();
+         i != this->facetChecks.end(); i++)
+    {
+        if (i->first == exceptAttr)
+            continue;
+
+        Kanki::RodsAVUIndex::AnyOf anyOf;
+
+        for (std::set<std::string>::const_iterator j = i->second.begin(); j != i->second.end(); j++)
+        {
+            Kanki::RodsAVUIndex::Term term;
+            term.attr = i->first;
+            term.value = *j;
+            anyOf.push_back(term);
+        }
+
+        filters.push_back(anyOf);
+    }
+
+    return (filters);
+}
+
+void RodsFindWindow::showFacetResults()
+{
+    std::vector<Kanki::RodsNameIndex::Entry> objs;
+
+    // the filtered objects supersede the search results
+    this->retireSearch();
+    this->resultModel->clear();
+
+    this->ui->executeButton->setText("Execute");
+    this->ui->executeButton->setDisabled(this->condWidgets.empty());
+    this->ui->resetButton->setDisabled(this->condWidgets.empty());
+
+    if (this->facetChecks.empty())
+    {
+        this->statusBar()->clearMessage();
+        return;
+    }
+
+    Kanki::RodsAVUIndex::Selection selection = this->avuIndex->select(this->facetFilters());
+
+    for (unsigned int i = 0; i < selection.size(); i++)
+    {
+        Kanki::RodsNameIndex::Entry entry;
+        entry.path = this->avuIndex->objectPath(selection.at(i));
+        entry.objType = DATA_OBJ_T;
+        objs.push_back(entry);
+    }
+
+    // the results are all local
+    this->resultModel->addLocalResults(objs);
+    this->resultModel->flushPending();
+
+    this->statusBar()->showMessage(QVariant((int)selection.size()).toString() + " data objects with the selected metadata.");
+}
+
+void RodsFindWindow::refreshFacets()
+{
+    Kanki::RodsAVUIndex::Selection selection = this->avuIndex->select(this->facetFilters());
+    Kanki::RodsAVUIndex::Counts attrCounts = this->avuIndex->attributeCounts(selection);
+
+    // checked attributes stay visible without matching objects
+    for (std::map<std::string, std::set<std::string> >::const_iterator i = this->facetChecks.begin();
+         i != this->facetChecks.end(); i++)
+        attrCounts.insert(std::make_pair(i->first, 0u));
+
+    // the tree is rebuilt without signaling changes
+    this->ui->facetTree->blockSignals(true);
+    this->ui->facetTree->clear();
+
+    for (Kanki::RodsAVUIndex::Counts::const_iterator i = attrCounts.begin(); i != attrCounts.end(); i++)
+    {
+        std::map<std::string, std::set<std::string> >::const_iterator checks = this->facetChecks.find(i->first);
+        std::vector<std::pair<unsigned int, std::string> > values;
+
+        // the values of a filtered attribute are counted within the filters of the other attributes
+        Kanki::RodsAVUIndex::Counts valueCounts = this->avuIndex->valueCounts(i->first,
+                checks == this->facetChecks.end() ? selection : this->avuIndex->select(this->facetFilters(i->first)));
+
+        if (checks != this->facetChecks.end())
+        {
+            for (std::set<std::string>::const_iterator j = checks->second.begin(); j != checks->second.end(); j++)
+                valueCounts.insert(std::make_pair(*j, 0u));
+        }
+
+        for (Kanki::RodsAVUIndex::Counts::const_iterator j = valueCounts.begin(); j != valueCounts.end(); j++)
+            values.push_back(std::make_pair(j->second, j->first));
+
+        std::stable_sort(values.begin(), values.end(), RodsFindWindow::moreObjects);
+
+        QTreeWidgetItem *attrItem = new QTreeWidgetItem(this->ui->facetTree);
+        attrItem->setText(0, QString::fromStdString(this->schema->translateName(i->first)) +
+                          " (" + QVariant(i->second).toString() + ")");
+        attrItem->setData(0, Qt::UserRole, QString::fromStdString(i->first));
 
-        for (unsigned int i = 0; i < attrNames.size(); i ++)
-            this->attrMap[attrNames.at(i)] = this->schema->translateName(attrNames.at(i));
+        for (unsigned int j = 0; j < values.size(); j++)
+        {
+            bool checked = checks != this->facetChecks.end() && checks->second.count(values.at(j).second);
+
+            // the least common values are left out, unless checked
+            if (j >= RodsFindWindow::facetValueLimit && !checked)
+                continue;
+
+            QTreeWidgetItem *valueItem = new QTreeWidgetItem(attrItem);
+            valueItem->setText(0, QString::fromStdString(values.at(j).second) +
+                               " (" + QVariant(values.at(j).first).toString() + ")");
+            valueItem->setData(0, Qt::UserRole, QString::fromStdString(values.at(j).second));
+            valueItem->setFlags(valueItem->flags() | Qt::ItemIsUserCheckable);
+            valueItem->setCheckState(0, checked ? Qt::Checked : Qt::Unchecked);
+        }
+
+        attrItem->setExpanded(checks != this->facetChecks.end());
     }
+
+    this->ui->facetTree->blockSignals(false);
+}
+
+Kanki::RodsMetadataFacets::Facets RodsFindWindow::metadataAttributes(objType_t objType)
+{
+    std::map<int, Kanki::RodsMetadataFacets::Facets>::iterator attrs = this->metaAttrs.find(objType);
+    Kanki::RodsMetadataFacets::Facets counts;
+    int status = 0;
+
+    // the catalog wide counts are queried by the first metadata condition of the type
+    if (attrs != this->metaAttrs.end())
+        return (attrs->second);
+
+    // a failed query is tried again by the next condition
+    if ((status = this->metaFacets->attributeCounts(objType, &counts)) < 0)
+        this->statusBar()->showMessage("Metadata attribute query failed: " + QVariant(status).toString());
+
+    else
+        this->metaAttrs[objType] = counts;
+
+    return (counts);
+}
+
+bool RodsFindWindow::moreObjects(const std::pair<unsigned int, std::string> &a,
+                                 const std::pair<unsigned int, std::string> &b)
+{
+    return (a.first > b.first);
+}
+
+void RodsFindWindow::resetConditions()
+{
+    this->unregisterCondWidget(NULL);
 }
 
 void RodsFindWindow::unregisterCondWidget(RodsConditionWidget *ptr)
@@ -249,30 +752,103 @@ void RodsFindWindow::unregisterCondWidget(RodsConditionWidget *ptr)
         }
     }
 
-    if (!ptr)
+    if (ptr)
+    {
+        unsigned int group = this->condGroups[ptr];
+        this->condGroups.erase(ptr);
+
+        // the separator of a group left empty goes with it, unless conditions are being added to it
+        if (group != this->condGroup && !this->groupHasConditions(group) && this->groupLabels.count(group))
+        {
+            this->ui->criteriaLayout->removeWidget(this->groupLabels[group]);
+            delete (this->groupLabels[group]);
+            this->groupLabels.erase(group);
+        }
+    }
+
+    else {
         this->condWidgets.clear();
+        this->condGroups.clear();
+        this->condGroup = 0;
+
+        for (std::map<unsigned int, QLabel*>::iterator i = this->groupLabels.begin(); i != this->groupLabels.end(); i++)
+        {
+            this->ui->criteriaLayout->removeWidget(i->second);
+            delete (i->second);
+        }
 
-    // clear widgets and disable execute and reset
+        this->groupLabels.clear();
+    }
+
+    this->ui->orButton->setDisabled(!this->groupHasConditions(this->condGroup));
+
+    // clear widgets and disable execute and reset, a search being executed can still be cancelled
     if (this->condWidgets.empty())
     {
         this->ui->resetButton->setDisabled(true);
-        this->ui->executeButton->setDisabled(true);
+        this->ui->executeButton->setDisabled(!this->searchExec);
     }
 }
 
 void RodsFindWindow::resultDoubleClicked(const QModelIndex &index)
 {
-    // sanity check
+    // sanity check, only data objects are selected
     if (index.isValid() && index.parent().isValid())
     {
-        QTreeWidgetItem *item = static_cast<QTreeWidgetItem*>(index.internalPointer());
-        QTreeWidgetItem *parent = static_cast<QTreeWidgetItem*>(index.parent().internalPointer());
+        // get path and signal browser window to select path
+        QString path = QString::fromStdString(this->resultModel->objectPath(index));
+        this->selectObj(path);
+    }
+}
+
+void RodsFindWindow::exportResults()
+{
+    // the results shown so far are exported, a search being executed continues
+    this->resultModel->flushPending();
+
+    if (!this->resultModel->resultCount())
+    {
+        this->statusBar()->showMessage("No data objects to export.");
+        return;
+    }
+
+    this->exportObjs(this->resultObjects());
+}
+
+void RodsFindWindow::downloadResults()
+{
+    // the results shown so far are downloaded, a search being executed continues
+    this->resultModel->flushPending();
+
+    if (!this->resultModel->resultCount())
+    {
+        this->statusBar()->showMessage("No data objects to download.");
+        return;
+    }
+
+    this->downloadObjs(this->resultObjects());
+}
 
-        if (item && parent)
+Kanki::RodsObjGroups RodsFindWindow::resultObjects() const
+{
+    Kanki::RodsObjGroups objs;
+
+    // collections are at the top level of the model, their data objects below them
+    for (int i = 0; i < this->resultModel->rowCount(QModelIndex()); i++)
+    {
+        QModelIndex collIndex = this->resultModel->index(i, 0, QModelIndex());
+        std::pair<std::string, std::vector<std::string> > group;
+
+        group.first = this->resultModel->objectPath(collIndex);
+
+        for (int j = 0; j < this->resultModel->rowCount(collIndex); j++)
         {
-            // get path and signal browser window to select path
-            QString path = parent->data(0, Qt::DisplayRole).toString() + "/" + item->data(0, Qt::DisplayRole).toString();
-            this->selectObj(path);
+            QModelIndex objIndex = this->resultModel->index(j, 0, collIndex);
+            group.second.push_back(this->resultModel->data(objIndex, Qt::DisplayRole).toString().toStdString());
         }
+
+        objs.push_back(group);
     }
+
+    return (objs);
 }
@@ -17,15 +17,26 @@
 // C++ standard library headers
 #include <chrono>
 #include <vector>
+#include <map>
+#include <set>
+#include <utility>
+#include <algorithm>
 
 // Qt framework headers
 #include <QMainWindow>
 #include <QInputDialog>
 #include <QIcon>
+#include <QTimer>
+#include <QTreeWidgetItem>
+#include <QLabel>
+#include <QApplication>
 
 // Kanki iRODS C++ class library headers
 #include "rodsconnection.h"
+#include "rodsconnectionpool.h"
 #include "_rodsgenquery.h"
+#include "rodsavuindex.h"
+#include "rodsmetadatafacets.h"
 
 // application headers
 #include "rodsmetadataschema.h"
@@ -33,6 +44,9 @@
 #include "rodsstringconditionwidget.h"
 #include "rodsdateconditionwidget.h"
 #include "rodsmetadataconditionwidget.h"
+#include "rodsfindresultmodel.h"
+#include "rodsexportthread.h"
+#include "rodsdownloadthread.h"
 
 // Qt UI compiler namespace for generated classes
 namespace Ui {
@@ -63,14 +77,38 @@ signals:
     // Qt signal for selecting an object in the grid browser, signals out path
     void selectObj(QString objPath);
 
+    // Qt signal for exporting a listing of data objects, signals out the data objects by collection
+    void exportObjs(const Kanki::RodsObjGroups &objs);
+
+    // Qt signal for downloading data objects in one job, signals out the data objects by collection
+    void downloadObjs(const Kanki::RodsObjGroups &objs);
+
 public slots:
 
     // Qt slot for requesting to add a condition
     void addCondition();
 
-    // Qt slot for requesting to execute
+    // Qt slot for starting a group of conditions alternative to the previous groups
+    void addConditionGroup();
+
+    // Qt slot for requesting to execute, or to cancel a search being executed
     void executeSearch();
 
+    // Qt slot for following the progress of the search being executed
+    void updateSearchProgress();
+
+    // Qt slot for (re)starting the delay of a quick search as the search text is edited
+    void quickSearchEdited(const QString &text);
+
+    // Qt slot for executing a quick search by the search text, superseding the search being executed
+    void executeQuickSearch();
+
+    // Qt slot for indexing the metadata of a collection subtree for faceted browsing, or refreshing it
+    void indexMetadata();
+
+    // Qt slot for filtering the indexed objects as metadata values are checked and unchecked
+    void facetItemChanged(QTreeWidgetItem *item, int column);
+
     // Qt slot for resetting the find window
     void resetConditions();
 
@@ -80,6 +118,12 @@ public slots:
     // Qt slot for invoking an object selection in the grid browser
     void resultDoubleClicked(const QModelIndex &index);
 
+    // Qt slot for exporting the data objects found
+    void exportResults();
+
+    // Qt slot for downloading the data objects found
+    void downloadResults();
+
 protected:
 
     // Qt close window event handler, invokes unregister signal.
@@ -87,26 +131,111 @@ protected:
 
 private:
 
-    // refresh available data object attributes from iCAT
-    void refreshMetadataAttrs();
+    // makes a search query from the search text and the conditions of the condition widgets, for
+    // several condition groups also the group partitions
+    Kanki::RodsGenQuery* makeSearchQuery();
+
+    // returns whether a condition group has conditions
+    bool groupHasConditions(unsigned int group) const;
+
+    // returns the names of the data objects in the result model by collection
+    Kanki::RodsObjGroups resultObjects() const;
+
+    // makes data object id range partitions for executing a search query in parallel
+    std::vector<Kanki::RodsGenQuery::Partition> searchPartitions();
+
+    // starts the asynchronous execution of the search query, optionally partitioned
+    void startSearch(bool partitioned);
+
+    // finishes the search being executed and reports its results
+    void finishSearch();
+
+    // cancels the search being executed without waiting for it, it is freed once finished
+    void retireSearch();
+
+    // frees the retired searches which have finished
+    void reapSearches();
+
+    // makes the metadata filters from the checked values, optionally leaving out an attribute
+    std::vector<Kanki::RodsAVUIndex::AnyOf> facetFilters(const std::string &exceptAttr = std::string()) const;
+
+    // shows the indexed objects matching the checked values as the search results
+    void showFacetResults();
+
+    // rebuilds the facet tree with the value counts within the current filters
+    void refreshFacets();
+
+    // returns the attribute counts for the metadata condition widgets of an object type, queried
+    // once per find window, query errors are reported in the status bar
+    Kanki::RodsMetadataFacets::Facets metadataAttributes(objType_t objType);
+
+    // orders facet values by descending object count
+    static bool moreObjects(const std::pair<unsigned int, std::string> &a, const std::pair<unsigned int, std::string> &b);
+
+    // count of parallel connections (and partitions) for executing search queries
+    static const unsigned int searchConns;
+
+    // delay in milliseconds after the last edit before a quick search, and the minimum length
+    // of the search text
+    static const int quickSearchDelay;
+    static const int quickSearchMinLength;
+
+    // maximum count of values shown for an attribute in the facet tree
+    static const unsigned int facetValueLimit;
 
     // instance of Qt UI compiler generated UI
     Ui::RodsFindWindow *ui;
 
-    // icon for a search result
-    QIcon dataIcon, collIcon;
-
     // our connection object
     Kanki::RodsConnection *conn;
 
+    // pool of connections for parallel search query execution
+    Kanki::RodsConnectionPool *connPool;
+
+    // search query and its asynchronous execution, while a search is being executed
+    Kanki::RodsGenQuery *searchQuery;
+    Kanki::RodsGenQuery::ExecutionPtr searchExec;
+    bool searchPartitioned;
+
+    // alternative condition groups of the search query as partitions, empty for a single group
+    std::vector<Kanki::RodsGenQuery::Partition> searchGroups;
+
+    // cancelled searches still being executed and their queries, freed once finished
+    std::vector<Kanki::RodsGenQuery::ExecutionPtr> retiredExecs;
+    std::vector<Kanki::RodsGenQuery*> retiredQueries;
+
+    // model of the search results, filled page by page while a search is being executed
+    RodsFindResultModel *resultModel;
+
+    // start time of the search being executed
+    std::chrono::high_resolution_clock::time_point searchStart;
+
+    // Qt timer for following the search progress and showing the results received
+    QTimer *progressTimer;
+
+    // Qt timer for delaying a quick search until the search text is no longer edited
+    QTimer *quickSearchTimer;
+
+    // local index of the metadata of a collection subtree, and the checked values by attribute
+    Kanki::RodsAVUIndex *avuIndex;
+    std::map<std::string, std::set<std::string> > facetChecks;
+
+    // server side metadata facet counts for the metadata condition widgets, and the attribute
+    // counts by object type
+    Kanki::RodsMetadataFacets *metaFacets;
+    std::map<int, Kanki::RodsMetadataFacets::Facets> metaAttrs;
+
     // our schema instance
     RodsMetadataSchema *schema;
 
     // container for condition widgets (to be added dynamically)
     std::vector<RodsConditionWidget*> condWidgets;
 
-    // container for available metadata attributes
-    std::map<std::string, std::string> attrMap;
+    // condition group of each condition widget, the group conditions are added to and the labels
+    // separating the groups
+    std::map<RodsConditionWidget*, unsigned int> condGroups;
+    unsigned int condGroup;
+    std::map<unsigned int, QLabel*> groupLabels;
 };
 
 #endif // RODSFINDWINDOW_H
@@ -16,152 +16,1044 @@
 
 namespace Kanki {
 
+// initialize static class constants
+const size_t RodsGenQuery::targetPageBytes = 4 * 1024 * 1024;
+const int RodsGenQuery::minPageRows = 16;
+
 RodsGenQuery::RodsGenQuery(Kanki::RodsConnection *theConn)
 {
     // set connection object pointer
     this->conn = theConn;
+
+    // by default, no row offset or limit
+    this->rowOffset = 0;
+    this->rowLimit = 0;
+
+    // by default, the largest page size and prefetch of the next page
+    this->pageSize = 0;
+    this->pagePrefetch = true;
+
+    // by default, results are not cached
+    this->cacheTTL = 0;
+
+    // rods api input is prepared on first execution
+    this->prepared = false;
+
+    // initially, no asynchronous execution
+    this->execution = NULL;
+}
+
+RodsGenQuery::~RodsGenQuery()
+{
+    this->unprepare();
 }
 
 void RodsGenQuery::addQueryAttribute(int rodsAttr)
 {
+    this->addQueryAttribute(rodsAttr, RodsGenQuery::selectPlain);
+}
+
+void RodsGenQuery::addQueryAttribute(int rodsAttr, int selectOpts)
+{
+    int attrIndex = -1;
+
+    // an attribute may be selected once for each aggregate, find the one with the same aggregate
+    for (unsigned int i = 0; i < this->queryAttrs.size() && attrIndex < 0; i++)
+    {
+        if (this->queryAttrs.at(i) == rodsAttr &&
+            (this->queryAttrOpts.at(i) & ~(ORDER_BY | ORDER_BY_DESC)) == (selectOpts & ~(ORDER_BY | ORDER_BY_DESC)))
+            attrIndex = i;
+    }
+
     // if we already don't have the said attribute
-    if (!this->hasAttribute(rodsAttr))
+    if (attrIndex < 0)
     {
         // push attribute to vector of query attributes
         this->queryAttrs.push_back(rodsAttr);
+        this->queryAttrOpts.push_back(selectOpts);
     }
+
+    // otherwise update select options
+    else
+        this->queryAttrOpts[attrIndex] = selectOpts;
+
+    // prepared input is out of date
+    this->unprepare();
+}
+
+void RodsGenQuery::setRowOffset(int offset)
+{
+    this->rowOffset = offset;
+}
+
+void RodsGenQuery::setRowLimit(int limit)
+{
+    this->rowLimit = limit;
 }
 
 void RodsGenQuery::addQueryCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, const std::string &valStr)
 {
     // make new condition struct and push back of vector
     this->queryConds.push_back(RodsGenQuery::Condition(rodsAttr, rodsCondOpr, valStr));
+
+    // prepared input is out of date
+    this->unprepare();
 }
 
-int RodsGenQuery::execute()
+void RodsGenQuery::addQueryCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr,
+                                     const std::vector<std::string> &valStrs)
+{
+    std::string listStr;
+
+    // a single value needs no list, an equality condition also takes a value with a single quote
+    if (rodsCondOpr == RodsGenQuery::isIn && valStrs.size() == 1)
+    {
+        this->addQueryCondition(rodsAttr, RodsGenQuery::isEqual, valStrs.front());
+        return;
+    }
+
+    // the value list is stored formatted, each value quoted
+    for (unsigned int i = 0; i < valStrs.size(); i++)
+    {
+        if (i)
+            listStr += ", ";
+
+        listStr += "'" + valStrs.at(i) + "'";
+    }
+
+    this->addQueryCondition(rodsAttr, rodsCondOpr, listStr);
+}
+
+void RodsGenQuery::addQueryCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, int val)
+{
+    std::ostringstream valStr;
+    valStr << val;
+
+    this->addQueryCondition(rodsAttr, rodsCondOpr, valStr.str());
+}
+
+void RodsGenQuery::Partition::addCondition(int rodsAttr, RodsGenQuery::CondOpr rodsCondOpr, const std::string &valStr)
+{
+    this->condAttrs.push_back(rodsAttr);
+    this->condOprs.push_back(rodsCondOpr);
+    this->condVals.push_back(valStr);
+}
+
+void RodsGenQuery::Partition::addConditions(const RodsGenQuery &query)
+{
+    for (unsigned int i = 0; i < query.queryConds.size(); i++)
+    {
+        const RodsGenQuery::Condition &cond = query.queryConds.at(i);
+        this->addCondition(cond.attr, cond.condOpr, cond.valStr);
+    }
+}
+
+unsigned int RodsGenQuery::Partition::condCount() const
 {
-    genQueryInp_t queryInput;
-    genQueryOut_t *queryOutput;
-    int status = 0, prevStatus = 0;
+    return (this->condAttrs.size());
+}
+
+RodsGenQuery::Execution::Execution()
+{
+    this->worker = NULL;
+    this->rows = 0;
+    this->pages = 0;
+    this->cancelled = this->finished = false;
+    this->status = 0;
+}
+
+RodsGenQuery::Execution::~Execution()
+{
+    // a running execution is stopped before the handle goes away
+    this->cancel();
+    this->wait();
+}
+
+size_t RodsGenQuery::Execution::rowCount() const
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    return (this->rows);
+}
+
+unsigned int RodsGenQuery::Execution::pageCount() const
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    return (this->pages);
+}
+
+bool RodsGenQuery::Execution::isFinished() const
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    return (this->finished);
+}
+
+bool RodsGenQuery::Execution::isCancelled() const
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    return (this->cancelled);
+}
+
+void RodsGenQuery::Execution::cancel()
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
 
-    // if we have a previous query result set, flush previous results
-    if (this->resultTable.size())
-        this->resultTable.clear();
+    // a finished execution can't be cancelled anymore
+    if (!this->finished)
+        this->cancelled = true;
+}
+
+int RodsGenQuery::Execution::wait()
+{
+    // join and free the worker thread once
+    if (this->worker)
+    {
+        this->worker->join();
+        delete (this->worker);
+        this->worker = NULL;
+    }
+
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    return (this->status);
+}
+
+bool RodsGenQuery::Execution::pageReceived(int rows)
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    this->rows += rows;
+    this->pages++;
+
+    return (!this->cancelled);
+}
+
+void RodsGenQuery::Execution::finish(int status)
+{
+    boost::unique_lock<boost::mutex> lock(this->execMutex);
+
+    this->status = status;
+    this->finished = true;
+}
+
+RodsGenQuery::Page::Page(const genQueryOut_t *theOutput, const std::vector<int> *theAttrs, int theRowCount)
+{
+    this->output = theOutput;
+    this->attrs = theAttrs;
+    this->rows = theRowCount;
+}
+
+int RodsGenQuery::Page::rowCount() const
+{
+    return (this->rows);
+}
+
+int RodsGenQuery::Page::attrCount() const
+{
+    return (this->output->attriCnt);
+}
+
+int RodsGenQuery::Page::attributeAtIndex(int attrIndex) const
+{
+    return (this->attrs->at(attrIndex));
+}
+
+const char* RodsGenQuery::Page::value(int row, int attrIndex) const
+{
+    // sanity check for bounds
+    if (row < 0 || row >= this->rows || attrIndex < 0 || attrIndex >= this->output->attriCnt)
+        return (NULL);
+
+    // results are in fixed width rows for each attribute
+    const sqlResult_t &result = this->output->sqlResult[attrIndex];
+
+    return (result.value + row * result.len);
+}
+
+const char* RodsGenQuery::Page::valueForAttr(int row, int rodsAttr) const
+{
+    // find the index of the attribute
+    for (unsigned int i = 0; i < this->attrs->size(); i++)
+    {
+        if (this->attrs->at(i) == rodsAttr)
+            return (this->value(row, i));
+    }
+
+    return (NULL);
+}
+
+std::string RodsGenQuery::formatCondition(const RodsGenQuery::Condition &cond)
+{
+    std::string condStr;
+
+    // build conditions string depending on condition operator
+    if (cond.condOpr == RodsGenQuery::isEqual)
+        condStr += "=";
+    else if (cond.condOpr == RodsGenQuery::isNotEqual)
+        condStr += "!=";
+    else if (cond.condOpr == RodsGenQuery::isLess)
+        condStr += "<";
+    else if (cond.condOpr == RodsGenQuery::isLessOrEqual)
+        condStr += "<=";
+    else if (cond.condOpr == RodsGenQuery::isGreater)
+        condStr += ">";
+    else if (cond.condOpr == RodsGenQuery::isGreaterOrEqual)
+        condStr += ">=";
+    else if (cond.condOpr == RodsGenQuery::isLike)
+        condStr += "like ";
+    else if (cond.condOpr == RodsGenQuery::isNotLike)
+        condStr += "not like ";
+
+    // a value list is already quoted
+    else if (cond.condOpr == RodsGenQuery::isIn)
+        return ("in (" + cond.valStr + ")");
+
+    // append condition value into expression
+    condStr += "'" + cond.valStr + "'";
+
+    return (condStr);
+}
+
+void RodsGenQuery::prepare()
+{
+    // if the input is up to date, there is nothing to do
+    if (this->prepared)
+        return;
 
     // zero rods api data structures
-    memset(&queryInput, 0, sizeof(genQueryInp_t));
-    queryOutput = NULL;
+    memset(&this->preparedInput, 0, sizeof(genQueryInp_t));
 
     // set rods api select array sizes
-    queryInput.selectInp.len = this->queryAttrs.size();
-    queryInput.maxRows = 100;
+    this->preparedInput.selectInp.len = this->queryAttrs.size();
 
     // allocate new arrays for rods api
-    queryInput.selectInp.inx = new int[this->queryAttrs.size()];
-    queryInput.selectInp.value = new int[this->queryAttrs.size()];
+    this->preparedInput.selectInp.inx = new int[this->queryAttrs.size()];
+    this->preparedInput.selectInp.value = new int[this->queryAttrs.size()];
 
     // build rods api select arrays
     for (unsigned int i = 0; i < this->queryAttrs.size(); i++)
     {
-        queryInput.selectInp.inx[i] = this->queryAttrs.at(i);
-        queryInput.selectInp.value[i] = 0;
+        this->preparedInput.selectInp.inx[i] = this->queryAttrs.at(i);
+        this->preparedInput.selectInp.value[i] = this->queryAttrOpts.at(i);
     }
 
     // set rods api condition array sizes
-    queryInput.sqlCondInp.len = this->queryConds.size();
+    this->preparedInput.sqlCondInp.len = this->queryConds.size();
 
     // allocate new arrays for rods api
-    queryInput.sqlCondInp.inx = new int[this->queryConds.size()];
-    queryInput.sqlCondInp.value = new char*[this->queryConds.size()];
+    this->preparedInput.sqlCondInp.inx = new int[this->queryConds.size()];
+    this->preparedInput.sqlCondInp.value = new char*[this->queryConds.size()];
+
+    // condition strings are kept in our own storage
+    this->condStrs.resize(this->queryConds.size());
 
     // build rods api cond arrays
     for (unsigned int i = 0; i < this->queryConds.size(); i++)
     {
-        RodsGenQuery::Condition cond = this->queryConds.at(i);
-        std::string condStr;
-
-        // build conditions string depending on condition operator
-        if (cond.condOpr == RodsGenQuery::isEqual)
-            condStr += "=";
-        else if (cond.condOpr == RodsGenQuery::isNotEqual)
-            condStr += "!=";
-        else if (cond.condOpr == RodsGenQuery::isLess)
-            condStr += "<";
-        else if (cond.condOpr == RodsGenQuery::isLessOrEqual)
-            condStr += "<=";
-        else if (cond.condOpr == RodsGenQuery::isGreater)
-            condStr += ">";
-        else if (cond.condOpr == RodsGenQuery::isGreaterOrEqual)
-            condStr += ">=";
-        else if (cond.condOpr == RodsGenQuery::isLike)
-            condStr += "like ";
-
-        // append condition value into expression
-        condStr += "'" + cond.valStr + "'";
+        this->condStrs.at(i) = RodsGenQuery::formatCondition(this->queryConds.at(i));
 
         // insert into rods api arrays
-        queryInput.sqlCondInp.inx[i] = cond.attr;
-        queryInput.sqlCondInp.value[i] = strdup(condStr.c_str());
+        this->preparedInput.sqlCondInp.inx[i] = this->queryConds.at(i).attr;
+        this->preparedInput.sqlCondInp.value[i] = &this->condStrs.at(i)[0];
+    }
+
+    this->prepared = true;
+}
+
+void RodsGenQuery::unprepare()
+{
+    // if there is no prepared input, there is nothing to do
+    if (!this->prepared)
+        return;
+
+    // free rods api allocated resources
+    delete[] this->preparedInput.selectInp.inx;
+    delete[] this->preparedInput.selectInp.value;
+    delete[] this->preparedInput.sqlCondInp.inx;
+    delete[] this->preparedInput.sqlCondInp.value;
+
+    this->prepared = false;
+}
+
+void RodsGenQuery::setConditionValue(unsigned int condIndex, const std::string &valStr)
+{
+    // sanity check for bounds
+    if (condIndex >= this->queryConds.size())
+        return;
+
+    this->queryConds.at(condIndex).valStr = valStr;
+
+    // substitute the value into the prepared input in place
+    if (this->prepared)
+    {
+        this->condStrs.at(condIndex) = RodsGenQuery::formatCondition(this->queryConds.at(condIndex));
+        this->preparedInput.sqlCondInp.value[condIndex] = &this->condStrs.at(condIndex)[0];
+    }
+}
+
+int RodsGenQuery::execute()
+{
+    std::string sig;
+    int status = 0;
+
+    // answer from the query result cache when allowed
+    if (this->cacheTTL > 0)
+    {
+        sig = this->signature();
+
+        if (this->conn->queryCache()->lookup(sig, &this->results))
+            return (status);
+    }
+
+    // flush previous results, reusing the result storage when the attributes are the same
+    if (this->results.hasAttributes(this->queryAttrs))
+        this->results.clear();
+
+    else
+        this->results.reset(this->queryAttrs);
+
+    // stream all the pages into local storage
+    status = this->executeStreaming(boost::bind(&RodsGenQuery::storePage, this, _1));
+
+    // cache the results, depending on the attributes and the condition attributes
+    if (this->cacheTTL > 0 && status >= 0)
+    {
+        std::vector<int> attrs = this->queryAttrs;
+
+        for (unsigned int i = 0; i < this->queryConds.size(); i++)
+            attrs.push_back(this->queryConds.at(i).attr);
+
+        this->conn->queryCache()->store(sig, attrs, this->results, this->cacheTTL);
+    }
+
+    return (status);
+}
+
+void RodsGenQuery::setCacheTTL(int seconds)
+{
+    this->cacheTTL = seconds;
+}
+
+std::string RodsGenQuery::signature() const
+{
+    std::vector<std::string> conds;
+    std::ostringstream sig;
+
+    // attribute order determines the result columns
+    for (unsigned int i = 0; i < this->queryAttrs.size(); i++)
+        sig << this->queryAttrs.at(i) << ":" << this->queryAttrOpts.at(i) << ",";
+
+    // condition order doesn't matter
+    for (unsigned int i = 0; i < this->queryConds.size(); i++)
+    {
+        std::ostringstream condStr;
+
+        condStr << this->queryConds.at(i).attr << " " << RodsGenQuery::formatCondition(this->queryConds.at(i));
+        conds.push_back(condStr.str());
+    }
+
+    std::sort(conds.begin(), conds.end());
+
+    for (unsigned int i = 0; i < conds.size(); i++)
+        sig << "|" << conds.at(i);
+
+    sig << "|" << this->rowOffset << ":" << this->rowLimit;
+
+    return (sig.str());
+}
+
+bool RodsGenQuery::storePage(const RodsGenQuery::Page &page)
+{
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        for (int j = 0; j < page.attrCount(); j++)
+        {
+            // append result entry into the column arena
+            this->results.append(j, page.value(i, j));
+        }
+    }
+
+    // an asynchronous execution continues to the next page unless cancelled
+    if (this->execution)
+        return (this->execution->pageReceived(page.rowCount()));
+
+    return (true);
+}
+
+bool RodsGenQuery::streamPage(const RodsGenQuery::PageHandler &pageHandler, const RodsGenQuery::Page &page)
+{
+    bool more = pageHandler(page);
+
+    // an asynchronous execution continues to the next page unless cancelled
+    if (this->execution)
+        more = this->execution->pageReceived(page.rowCount()) && more;
+
+    return (more);
+}
+
+int RodsGenQuery::tunePageSize(const genQueryOut_t *queryOutput)
+{
+    size_t rowBytes = 0;
+
+    // the server returns fixed width rows, the width of the widest value for each attribute
+    for (int i = 0; i < queryOutput->attriCnt; i++)
+        rowBytes += queryOutput->sqlResult[i].len;
+
+    if (!rowBytes)
+        return (MAX_SQL_ROWS);
+
+    // the server maximum is a clamp, only rows wider than targetPageBytes / MAX_SQL_ROWS
+    // make a page of fewer rows
+    size_t rows = RodsGenQuery::targetPageBytes / rowBytes;
+
+    return (std::max(RodsGenQuery::minPageRows, std::min((int)rows, MAX_SQL_ROWS)));
+}
+
+void RodsGenQuery::fetchPages(RodsGenQuery::PageFetch *fetch)
+{
+    boost::unique_lock<boost::mutex> lock(fetch->fetchMutex);
+
+    while (true)
+    {
+        // wait for the next page to be requested, or for the continuation to end
+        while (!fetch->requested && !fetch->stopped)
+            fetch->fetchCond.wait(lock);
+
+        if (!fetch->requested)
+            break;
+
+        genQueryOut_t *queryOutput = NULL;
+
+        // the request is made without holding the fetch state
+        lock.unlock();
+        int status = rcGenQuery(fetch->commPtr, fetch->queryInput, &queryOutput);
+        lock.lock();
+
+        fetch->queryOutput = queryOutput;
+        fetch->status = status;
+        fetch->requested = false;
+        fetch->fetchCond.notify_all();
     }
+}
 
-    // lock rods connection mutex
+int RodsGenQuery::executeStreaming(RodsGenQuery::PageHandler pageHandler)
+{
+    genQueryOut_t *queryOutput = NULL;
+    RodsGenQuery::PageFetch fetch;
+    boost::thread *fetcher = NULL;
+    int status = 0, rowCount = 0;
+    bool more = true;
+
+    // build the rods api input once, executions share the arrays of the prepared input
+    this->prepare();
+    genQueryInp_t queryInput = this->preparedInput;
+
+    queryInput.maxRows = this->pageSize > 0 ? std::min(this->pageSize, MAX_SQL_ROWS) : MAX_SQL_ROWS;
+    queryInput.rowOffset = this->rowOffset;
+
+    // don't ask for more rows than we are going to fetch
+    if (this->rowLimit > 0 && this->rowLimit < queryInput.maxRows)
+        queryInput.maxRows = this->rowLimit;
+
+    // one fetch worker requests the pages for the whole continuation
+    fetch.commPtr = this->conn->commPtr();
+    fetch.queryInput = &queryInput;
+    fetch.queryOutput = NULL;
+    fetch.status = 0;
+    fetch.requested = false;
+    fetch.stopped = false;
+
+    // lock rods connection mutex for the duration of the continuation
     this->conn->mutexLock();
 
     // try to execute a generic query
-    if (!(status = rcGenQuery(this->conn->commPtr(), &queryInput, &queryOutput)))
+    status = rcGenQuery(this->conn->commPtr(), &queryInput, &queryOutput);
+
+    // iterate while there are results to process
+    while (!status && queryOutput)
     {
-        // on success, initialize result buffer vectors
-        for (unsigned int i = 0; i < this->queryAttrs.size(); i++)
-            this->resultTable[this->queryAttrs.at(i)] = std::vector<std::string>();
+        genQueryOut_t *nextOutput = NULL;
+        int pageRows = queryOutput->rowCnt, nextStatus = 0;
+        bool hasNext = queryOutput->continueInx != 0;
+        bool prefetched = false;
+
+        // stop at the row limit
+        if (this->rowLimit > 0 && rowCount + pageRows > this->rowLimit)
+            pageRows = this->rowLimit - rowCount;
+
+        rowCount += pageRows;
+
+        bool limitReached = this->rowLimit > 0 && rowCount >= this->rowLimit;
+
+        if (hasNext)
+        {
+            queryInput.continueInx = queryOutput->continueInx;
+
+            // page size from the row width of the current page
+            if (this->pageSize <= 0)
+                queryInput.maxRows = RodsGenQuery::tunePageSize(queryOutput);
+
+            // don't ask for more rows than we are going to fetch
+            if (this->rowLimit > 0 && this->rowLimit - rowCount < queryInput.maxRows)
+                queryInput.maxRows = this->rowLimit - rowCount;
+
+            // request the next page while the current one is consumed, the connection
+            // is locked for us and we wait for the request before going on
+            if (this->pagePrefetch && !limitReached)
+            {
+                if (!fetcher)
+                    fetcher = new boost::thread(boost::bind(&RodsGenQuery::fetchPages, &fetch));
+
+                boost::unique_lock<boost::mutex> lock(fetch.fetchMutex);
+
+                fetch.requested = true;
+                fetch.fetchCond.notify_all();
+                prefetched = true;
+            }
+        }
+
+        // hand out the page, the handler may ask us to stop
+        if (pageRows > 0)
+            more = pageHandler(RodsGenQuery::Page(queryOutput, &this->queryAttrs, pageRows));
+
+        if (prefetched)
+        {
+            boost::unique_lock<boost::mutex> lock(fetch.fetchMutex);
+
+            while (fetch.requested)
+                fetch.fetchCond.wait(lock);
+
+            nextOutput = fetch.queryOutput;
+            nextStatus = fetch.status;
+            fetch.queryOutput = NULL;
+        }
+
+        freeGenQueryOut(&queryOutput);
+        queryOutput = NULL;
+
+        // if there are no more results to query, exit loop
+        if (!hasNext)
+            break;
 
-        // iterate while there are results to process
-        do {
-            for (int i = 0; i < queryOutput->rowCnt; i++)
+        // the next page has been requested already
+        if (prefetched)
+        {
+            queryOutput = nextOutput;
+
+            // if the caller is done, close the query on the server
+            if (!more)
             {
-                for (int j = 0; j < queryOutput->attriCnt; j++)
+                if (!nextStatus && queryOutput && queryOutput->continueInx)
                 {
-                    // pointer arithmetic for attribute i result entry j
-                    char *resultPtr = queryOutput->sqlResult[j].value;
-                    resultPtr += i * queryOutput->sqlResult[j].len;
+                    queryInput.continueInx = queryOutput->continueInx;
+                    queryInput.maxRows = 0;
+
+                    freeGenQueryOut(&queryOutput);
+                    queryOutput = NULL;
 
-                    // push result entry into hashtable storage
-                    (this->resultTable[this->queryAttrs.at(j)]).push_back(resultPtr);
+                    rcGenQuery(this->conn->commPtr(), &queryInput, &queryOutput);
                 }
-            }
 
-            // if there are no more results to query, exit loop
-            if (!queryOutput->continueInx)
                 break;
+            }
 
-            // otherwise continue fetching query results
-            queryInput.continueInx = queryOutput->continueInx;
-            prevStatus = status;
+            status = nextStatus;
+        }
+
+        // if the caller is done or we have reached the row limit, close the query on the server
+        else if (!more || limitReached)
+        {
+            queryInput.maxRows = 0;
+            rcGenQuery(this->conn->commPtr(), &queryInput, &queryOutput);
 
+            break;
+        }
+
+        // otherwise continue fetching query results
+        else
             status = rcGenQuery(this->conn->commPtr(), &queryInput, &queryOutput);
-        } while (!status);
     }
 
-    // release rods connection mutex
-    this->conn->mutexUnlock();
+    // stop the fetch worker, it has no request pending
+    if (fetcher)
+    {
+        {
+            boost::unique_lock<boost::mutex> lock(fetch.fetchMutex);
 
-    // free rods api allocated resources
-    delete queryInput.selectInp.inx;
-    delete queryInput.selectInp.value;
+            fetch.stopped = true;
+            fetch.fetchCond.notify_all();
+        }
+
+        fetcher->join();
+        delete (fetcher);
+    }
 
-    for (unsigned int i = 0; i < this->queryConds.size(); i ++)
-        delete queryInput.sqlCondInp.value[i];
+    // release rods connection mutex
+    this->conn->mutexUnlock();
 
-    delete queryInput.sqlCondInp.inx;
-    delete queryInput.sqlCondInp.value;
+    if (queryOutput)
+        freeGenQueryOut(&queryOutput);
 
     // let's not return no more rows found as an error
     if (status == CAT_NO_ROWS_FOUND)
-        status = prevStatus;
+        status = 0;
 
     // return last rods api status to caller
     return (status);
 }
 
+int RodsGenQuery::executePartitioned(Kanki::RodsConnectionPool *pool,
+                                     const std::vector<RodsGenQuery::Partition> &partitions)
+{
+    RodsGenQuery::PartitionJob job;
+    int status = 0;
+
+    job.pool = pool;
+    job.partitions = &partitions;
+    job.partResults.resize(partitions.size());
+    job.partStatus.resize(partitions.size(), 0);
+    job.nextPartition = 0;
+
+    this->runPartitions(&job);
+
+    // flush previous results, reusing the result storage when the attributes are the same
+    if (this->results.hasAttributes(this->queryAttrs))
+        this->results.clear();
+
+    else
+        this->results.reset(this->queryAttrs);
+
+    // merge the partition results in order, up to the row limit
+    for (unsigned int i = 0; i < partitions.size(); i++)
+    {
+        if (job.partStatus.at(i) < 0)
+        {
+            status = job.partStatus.at(i);
+            break;
+        }
+
+        if (this->rowLimit > 0)
+        {
+            if ((int)this->results.rowCount() >= this->rowLimit)
+                break;
+
+            this->results.appendRows(job.partResults.at(i), this->rowLimit - this->results.rowCount());
+        }
+
+        else
+            this->results.appendRows(job.partResults.at(i));
+    }
+
+    return (status);
+}
+
+int RodsGenQuery::executePartitionedStreaming(Kanki::RodsConnectionPool *pool,
+                                              const std::vector<RodsGenQuery::Partition> &partitions,
+                                              RodsGenQuery::PageHandler pageHandler)
+{
+    RodsGenQuery::PartitionJob job;
+
+    job.pool = pool;
+    job.partitions = &partitions;
+    job.pageHandler = pageHandler;
+    job.partStatus.resize(partitions.size(), 0);
+    job.nextPartition = 0;
+
+    this->runPartitions(&job);
+
+    // the first failed partition determines the status
+    for (unsigned int i = 0; i < partitions.size(); i++)
+    {
+        if (job.partStatus.at(i) < 0)
+            return (job.partStatus.at(i));
+    }
+
+    return (0);
+}
+
+void RodsGenQuery::runPartitions(RodsGenQuery::PartitionJob *job) const
+{
+    std::vector<boost::thread*> workers;
+
+    // there is no use for more workers than pooled connections
+    unsigned int numWorkers = std::min((unsigned int)job->partitions->size(), job->pool->maxSize());
+
+    for (unsigned int i = 0; i < numWorkers; i++)
+        workers.push_back(new boost::thread(boost::bind(&RodsGenQuery::executePartitions, this, job)));
+
+    for (unsigned int i = 0; i < workers.size(); i++)
+    {
+        workers.at(i)->join();
+        delete (workers.at(i));
+    }
+}
+
+void RodsGenQuery::executePartitions(RodsGenQuery::PartitionJob *job) const
+{
+    while (true)
+    {
+        unsigned int partIndex = 0;
+        Kanki::RodsConnection *partConn = NULL;
+        int status = 0;
+
+        // take the next partition to execute
+        {
+            boost::unique_lock<boost::mutex> lock(job->jobMutex);
+
+            if (job->nextPartition >= job->partitions->size())
+                return;
+
+            partIndex = job->nextPartition++;
+        }
+
+        // a cancelled execution skips the rest of the partitions
+        if (this->execution && this->execution->isCancelled())
+            continue;
+
+        if ((partConn = job->pool->acquire(&status)) == NULL)
+        {
+            job->partStatus.at(partIndex) = status;
+            continue;
+        }
+
+        // the execution may have been cancelled while waiting for a connection
+        if (this->execution && this->execution->isCancelled())
+        {
+            job->pool->release(partConn);
+            continue;
+        }
+
+        const RodsGenQuery::Partition &part = job->partitions->at(partIndex);
+        RodsGenQuery partQuery(partConn);
+
+        // the partition query is this query with the partition conditions added
+        for (unsigned int i = 0; i < this->queryAttrs.size(); i++)
+            partQuery.addQueryAttribute(this->queryAttrs.at(i), this->queryAttrOpts.at(i));
+
+        for (unsigned int i = 0; i < this->queryConds.size(); i++)
+        {
+            const RodsGenQuery::Condition &cond = this->queryConds.at(i);
+            partQuery.addQueryCondition(cond.attr, cond.condOpr, cond.valStr);
+        }
+
+        for (unsigned int i = 0; i < part.condCount(); i++)
+            partQuery.addQueryCondition(part.condAttrs.at(i), part.condOprs.at(i), part.condVals.at(i));
+
+        partQuery.setRowLimit(this->rowLimit);
+        partQuery.setPageSize(this->pageSize);
+        partQuery.setPagePrefetch(this->pagePrefetch);
+
+        // partitions report their progress to the execution of this query
+        partQuery.execution = this->execution;
+
+        // a streaming execution hands out the pages right away, otherwise they are merged later
+        if (job->pageHandler)
+            job->partStatus.at(partIndex) = partQuery.executeStreaming(
+                        boost::bind(&RodsGenQuery::streamPage, &partQuery, boost::cref(job->pageHandler), _1));
+
+        else {
+            job->partStatus.at(partIndex) = partQuery.execute();
+            partQuery.takeResult(&job->partResults.at(partIndex));
+        }
+
+        job->pool->release(partConn);
+    }
+}
+
+RodsGenQuery::ExecutionPtr RodsGenQuery::executeAsync()
+{
+    return (this->executeAsync(NULL, std::vector<RodsGenQuery::Partition>(), RodsGenQuery::PageHandler()));
+}
+
+RodsGenQuery::ExecutionPtr RodsGenQuery::executeAsync(Kanki::RodsConnectionPool *pool,
+                                                      const std::vector<RodsGenQuery::Partition> &partitions)
+{
+    return (this->executeAsync(pool, partitions, RodsGenQuery::PageHandler()));
+}
+
+RodsGenQuery::ExecutionPtr RodsGenQuery::executeAsync(RodsGenQuery::PageHandler pageHandler)
+{
+    return (this->executeAsync(NULL, std::vector<RodsGenQuery::Partition>(), pageHandler));
+}
+
+RodsGenQuery::ExecutionPtr RodsGenQuery::executeAsync(Kanki::RodsConnectionPool *pool,
+                                                      const std::vector<RodsGenQuery::Partition> &partitions,
+                                                      RodsGenQuery::PageHandler pageHandler)
+{
+    RodsGenQuery::ExecutionPtr exec(new RodsGenQuery::Execution());
+
+    // without a pool, the query is executed sequentially on the query connection
+    if (pool)
+        exec->partitions = partitions;
+
+    exec->pageHandler = pageHandler;
+
+    this->execution = exec.get();
+    exec->worker = new boost::thread(boost::bind(&RodsGenQuery::executeWorker, this, exec.get(), pool));
+
+    return (exec);
+}
+
+void RodsGenQuery::executeWorker(RodsGenQuery::Execution *exec, Kanki::RodsConnectionPool *pool)
+{
+    int status = 0;
+
+    if (exec->partitions.empty())
+    {
+        if (exec->pageHandler)
+            status = this->executeStreaming(boost::bind(&RodsGenQuery::streamPage, this,
+                                                        boost::cref(exec->pageHandler), _1));
+
+        else
+            status = this->execute();
+    }
+
+    else if (exec->pageHandler)
+        status = this->executePartitionedStreaming(pool, exec->partitions, exec->pageHandler);
+
+    else
+        status = this->executePartitioned(pool, exec->partitions);
+
+    // the query is free for other use after this
+    this->execution = NULL;
+    exec->finish(status);
+}
+
+std::vector<RodsGenQuery::Partition> RodsGenQuery::collectionPartitions(const std::vector<std::string> &collPaths)
+{
+    std::vector<RodsGenQuery::Partition> partitions;
+
+    for (unsigned int i = 0; i < collPaths.size(); i++)
+    {
+        std::string collPath = collPaths.at(i), prefix = collPath;
+
+        if (collPath.length() > 1 && collPath.at(collPath.length() - 1) == '/')
+            collPath.erase(collPath.length() - 1);
+
+        if (prefix.empty() || prefix.at(prefix.length() - 1) != '/')
+            prefix += "/";
+
+        // the collection itself
+        RodsGenQuery::Partition self;
+        self.addCondition(COL_COLL_NAME, RodsGenQuery::isEqual, collPath);
+        partitions.push_back(self);
+
+        // everything below the collection, but not its siblings sharing the name prefix
+        RodsGenQuery::Partition below;
+        below.addCondition(COL_COLL_NAME, RodsGenQuery::isLike, RodsGenQuery::escapeLike(prefix) + "%");
+        partitions.push_back(below);
+    }
+
+    return (partitions);
+}
+
+std::vector<std::vector<std::string> > RodsGenQuery::makeValueBatches(const std::vector<std::string> &valStrs,
+                                                                      unsigned int batchSize)
+{
+    std::vector<std::vector<std::string> > batches;
+    std::vector<std::string> batch;
+
+    for (unsigned int i = 0; i < valStrs.size(); i++)
+    {
+        // the server takes the values of an in list between quotes without escapes,
+        // so a value with a single quote is queried on its own
+        if (valStrs.at(i).find('\'') != std::string::npos)
+            batches.push_back(std::vector<std::string>(1, valStrs.at(i)));
+
+        else
+        {
+            batch.push_back(valStrs.at(i));
+
+            if (batch.size() >= batchSize)
+            {
+                batches.push_back(batch);
+                batch.clear();
+            }
+        }
+    }
+
+    if (!batch.empty())
+        batches.push_back(batch);
+
+    return (batches);
+}
+
+std::string RodsGenQuery::escapeLike(const std::string &str)
+{
+    std::string escStr;
+
+    for (unsigned int i = 0; i < str.length(); i++)
+    {
+        if (str.at(i) == '%' || str.at(i) == '_' || str.at(i) == '\\')
+            escStr += '\\';
+
+        escStr += str.at(i);
+    }
+
+    return (escStr);
+}
+
+std::vector<RodsGenQuery::Partition> RodsGenQuery::combinePartitions(const std::vector<RodsGenQuery::Partition> &first,
+                                                                     const std::vector<RodsGenQuery::Partition> &second)
+{
+    std::vector<RodsGenQuery::Partition> partitions;
+
+    for (unsigned int i = 0; i < first.size(); i++)
+    {
+        for (unsigned int j = 0; j < second.size(); j++)
+        {
+            RodsGenQuery::Partition part = first.at(i);
+
+            part.condAttrs.insert(part.condAttrs.end(), second.at(j).condAttrs.begin(), second.at(j).condAttrs.end());
+            part.condOprs.insert(part.condOprs.end(), second.at(j).condOprs.begin(), second.at(j).condOprs.end());
+            part.condVals.insert(part.condVals.end(), second.at(j).condVals.begin(), second.at(j).condVals.end());
+            partitions.push_back(part);
+        }
+    }
+
+    return (partitions);
+}
+
+std::vector<RodsGenQuery::Partition> RodsGenQuery::rangePartitions(int rodsAttr, rodsLong_t minVal, rodsLong_t maxVal,
+                                                                   unsigned int count)
+{
+    std::vector<RodsGenQuery::Partition> partitions;
+
+    if (!count || maxVal < minVal)
+        return (partitions);
+
+    rodsLong_t span = (maxVal - minVal) / count + 1;
+
+    // consecutive half-open ranges [lower, upper) covering the whole range
+    for (rodsLong_t lower = minVal; lower <= maxVal; lower += span)
+    {
+        std::ostringstream lowerStr, upperStr;
+        RodsGenQuery::Partition part;
+
+        lowerStr << lower;
+        upperStr << lower + span;
+
+        part.addCondition(rodsAttr, RodsGenQuery::isGreaterOrEqual, lowerStr.str());
+        part.addCondition(rodsAttr, RodsGenQuery::isLess, upperStr.str());
+        partitions.push_back(part);
+    }
+
+    return (partitions);
+}
+
+void RodsGenQuery::setPageSize(int rows)
+{
+    this->pageSize = rows;
+}
+
+void RodsGenQuery::setPagePrefetch(bool enabled)
+{
+    this->pagePrefetch = enabled;
+}
+
 int RodsGenQuery::attrCount() const
 {
     // simply return size of attribute vector
@@ -190,46 +1082,55 @@ int RodsGenQuery::attributeIndex(int rodsAttr) const
     return (-1);
 }
 
-std::vector<std::string> RodsGenQuery::getResultSet(unsigned int attrIndex) const
+const Kanki::RodsQueryResult& RodsGenQuery::result() const
 {
-    // if we are within bounds of the result vector
-    if (attrIndex < this->queryAttrs.size())
-    {
-        // return a copy of result vector at requsted index
-        return (this->getResultSetForAttr(this->queryAttrs.at(attrIndex)));
-    }
+    return (this->results);
+}
 
-    // otherwise return an empty vector
-    else
-        return (std::vector<std::string>());
+void RodsGenQuery::takeResult(Kanki::RodsQueryResult *dest)
+{
+    // the previous storage of the destination is reused by the next execution
+    dest->swap(this->results);
+    this->results.clear();
+}
+
+std::vector<std::string> RodsGenQuery::getResultSet(unsigned int attrIndex) const
+{
+    // return a copy of result column at requested index, empty when out of bounds
+    return (this->results.column(attrIndex));
 }
 
 std::vector< std::vector<std::string> > RodsGenQuery::getResultSet() const
 {
     std::vector< std::vector<std::string> > results;
 
-    // build result set from internal hashtable representation
-    for (unsigned int i = 0; i < this->queryAttrs.size(); i++)
-        results.push_back(this->getResultSetForAttr(this->queryAttrs.at(i)));
+    // build result set from internal columnar representation
+    for (int i = 0; i < this->results.attrCount(); i++)
+        results.push_back(this->results.column(i));
 
     return (results);
 }
 
 std::vector<std::string> RodsGenQuery::getResultSetForAttr(int rodsAttr) const
 {
-    // if we have a result set for the attribute, return a const reference
-    if (this->resultTable.find(rodsAttr) != this->resultTable.end())
-        return (this->resultTable.at(rodsAttr));
-
-    return (std::vector<std::string>());
+    // return a copy of the result column for the attribute, empty if not present
+    return (this->results.column(this->results.attributeIndex(rodsAttr)));
 }
 
 void RodsGenQuery::reset()
 {
+    // free prepared input
+    this->unprepare();
+
     // clear internal containers
     this->queryAttrs.clear();
+    this->queryAttrOpts.clear();
     this->queryConds.clear();
-    this->resultTable.clear();
+    this->results.reset(std::vector<int>());
+
+    // clear row offset and limit
+    this->rowOffset = 0;
+    this->rowLimit = 0;
 }
 
 } // namespace Kanki
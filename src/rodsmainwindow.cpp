@@ -25,6 +25,11 @@ RodsMainWindow::RodsMainWindow(QWidget *parent) :
     this->queueWindow = NULL;
     this->findWindow = NULL;
     this->model = NULL;
+    this->flatModel = NULL;
+    this->prefetcher = NULL;
+
+    // the flat object tree model is selected from the command line
+    this->flatTree = QApplication::arguments().contains("--flat-tree");
 
     // instantiate and configure Qt UI
     this->ui->setupUi(this);
@@ -61,10 +66,16 @@ RodsMainWindow::~RodsMainWindow()
         delete (this->conn);
     }
 
+    // stop prefetching before the model goes away
+    this->stopPrefetcher();
+
     // delete object tree model if exists
     if (this->model)
         delete (this->model);
 
+    if (this->flatModel)
+        delete (this->flatModel);
+
     // delete queue window if exists
     if (this->queueWindow)
         delete (this->queueWindow);
@@ -79,6 +90,13 @@ RodsMainWindow::~RodsMainWindow()
         this->metaEditors.erase(i);
     }
 
+    // delete all collection table windows
+    for (std::map<std::string, RodsCollTableWindow*>::iterator i = this->collTables.begin();
+         i != this->collTables.end(); i++)
+        delete (i->second);
+
+    this->collTables.clear();
+
     // tear down ui
     delete (this->ui);
 }
@@ -148,25 +166,50 @@ void RodsMainWindow::enterConnectedState()
     this->ui->statusBar->showMessage(statusMsg.c_str(), 10000);
     this->setWindowTitle(this->windowTitle() + " (Zone: " + QString(this->conn->rodsZone().c_str()) + ")");
 
+    // stop prefetching for a previous model
+    this->stopPrefetcher();
+
     // if there exists a previous model, delete it
     if (this->model)
         delete (this->model);
 
-    // instantiate new model for new connection
-    this->model = new RodsObjTreeModel(this->conn, this->conn->rodsHome());
+    if (this->flatModel)
+        delete (this->flatModel);
+
+    this->model = NULL;
+    this->flatModel = NULL;
+
+    // the name index of a new connection is built as collections are listed
+    this->conn->nameIndex()->setEnabled(this->ui->actionNameIndex->isChecked());
+
+    // instantiate new model for new connection and connect to model refresh interface slot
+    if (this->flatTree)
+    {
+        this->flatModel = new RodsObjFlatTreeModel(this->conn, this->conn->rodsHome());
+
+        connect(this, &RodsMainWindow::refreshObjectModelAtIndex, this->flatModel,
+                &RodsObjFlatTreeModel::refreshAtIndex);
+    }
+
+    else {
+        this->model = new RodsObjTreeModel(this->conn, this->conn->rodsHome());
 
-    // connect to model refresh interface slot
-    connect(this, &RodsMainWindow::refreshObjectModelAtIndex, this->model,
-            &RodsObjTreeModel::refreshAtIndex);
+        connect(this, &RodsMainWindow::refreshObjectModelAtIndex, this->model,
+                &RodsObjTreeModel::refreshAtIndex);
+    }
 
     // setup model with tree view and expand first item
-    this->ui->rodsObjTree->setModel(this->model);
-    this->ui->rodsObjTree->expand(this->model->index(0, 0, QModelIndex()));
+    this->ui->rodsObjTree->setModel(this->objModel());
+    this->ui->rodsObjTree->expand(this->objModel()->index(0, 0, QModelIndex()));
 
     // resize columns after tree view data has been initialized
-    for (int i = 0; i < this->model->columnCount(QModelIndex()); i++)
+    for (int i = 0; i < this->objModel()->columnCount(QModelIndex()); i++)
         this->ui->rodsObjTree->resizeColumnToContents(i);
 
+    // resume prefetching if the user has enabled it
+    if (this->ui->actionPrefetch->isChecked())
+        this->startPrefetcher();
+
     this->refreshResources();
 
     this->ui->actionConnect->setDisabled(true);
@@ -180,12 +223,16 @@ void RodsMainWindow::enterConnectedState()
     this->ui->actionUpload->setDisabled(false);
     this->ui->actionUploadDirectory->setDisabled(false);
     this->ui->actionDownload->setDisabled(false);
+    this->ui->actionExport->setDisabled(false);
     this->ui->rodsObjTree->setDisabled(false);
     this->ui->viewSize->setDisabled(false);
     this->ui->verifyChecksum->setDisabled(false);
     this->ui->allowOverwrite->setDisabled(false);
     this->ui->storageResc->setDisabled(false);
     this->ui->actionFind->setDisabled(false);
+    this->ui->actionCollTable->setDisabled(false);
+    this->ui->actionPrefetch->setDisabled(false);
+    this->ui->actionNameIndex->setDisabled(false);
 }
 
 void RodsMainWindow::enterDisconnectedState()
@@ -207,7 +254,11 @@ void RodsMainWindow::enterDisconnectedState()
     this->ui->actionUpload->setDisabled(true);
     this->ui->actionUploadDirectory->setDisabled(true);
     this->ui->actionDownload->setDisabled(true);
+    this->ui->actionExport->setDisabled(true);
     this->ui->actionFind->setDisabled(true);
+    this->ui->actionCollTable->setDisabled(true);
+    this->ui->actionPrefetch->setDisabled(true);
+    this->ui->actionNameIndex->setDisabled(true);
 
     // disable settings controls
     this->ui->verifyChecksum->setDisabled(true);
@@ -233,6 +284,19 @@ void RodsMainWindow::unregisterMetadataWindow(std::string objPath)
     }
 }
 
+void RodsMainWindow::unregisterCollTableWindow(std::string collPath)
+{
+    // try to find collection table instance
+    std::map<std::string, RodsCollTableWindow*>::iterator i = this->collTables.find(collPath);
+
+    // if found, unregister it
+    if (i != this->collTables.end())
+    {
+        delete (i->second);
+        this->collTables.erase(i);
+    }
+}
+
 void RodsMainWindow::unregisterQueueWindow()
 {
     // sanity check
@@ -261,9 +325,12 @@ void RodsMainWindow::mountPath()
         // try to read collection to see that it's readable (by the user)
         if ((status = this->conn->readColl(path.toStdString(), &tmp)) >= 0)
         {
-                // get the model in use and add the mount point to the model
-                RodsObjTreeModel *model = static_cast<RodsObjTreeModel*>(this->ui->rodsObjTree->model());
-                model->addMountPoint(path.toStdString());
+                // add the mount point to the model in use
+                if (this->flatModel)
+                    this->flatModel->addMountPoint(path.toStdString());
+
+                else
+                    this->model->addMountPoint(path.toStdString());
         }
 
         else
@@ -326,112 +393,249 @@ void RodsMainWindow::doMetadataEditorOpen()
     // sanity check for index validity
     if (curIndex.isValid())
     {
-        RodsObjTreeItem *selection = static_cast<RodsObjTreeItem*>(curIndex.internalPointer());
+        Kanki::RodsObjEntryPtr objEntry = this->objEntryAtIndex(curIndex);
 
-        // if we have a valid selection
-        if (selection)
+        // if we are talking about a proper item
+        if (objEntry)
         {
-            Kanki::RodsObjEntryPtr objEntry = selection->getObjEntryPtr();
-
-            // if we are talking about a proper item
-            if (objEntry)
-            {
-                RodsMetadataWindow *metaWindow = NULL;
-
-                // if we already don't have an editor window, make one
-                if (this->metaEditors.find(objEntry->getObjectFullPath()) != this->metaEditors.end())
-                    metaWindow = this->metaEditors.at(objEntry->getObjectFullPath());
+            RodsMetadataWindow *metaWindow = NULL;
 
-                else {
-                    metaWindow = new RodsMetadataWindow(conn, selection->getObjEntryPtr());
+            // if we already don't have an editor window, make one
+            if (this->metaEditors.find(objEntry->getObjectFullPath()) != this->metaEditors.end())
+                metaWindow = this->metaEditors.at(objEntry->getObjectFullPath());
 
-                    connect(metaWindow, &RodsMetadataWindow::unregister, this,
-                            &RodsMainWindow::unregisterMetadataWindow);
+            else {
+                metaWindow = new RodsMetadataWindow(conn, objEntry);
 
-                    this->metaEditors[objEntry->getObjectFullPath()] = metaWindow;
-                }
+                connect(metaWindow, &RodsMetadataWindow::unregister, this,
+                        &RodsMainWindow::unregisterMetadataWindow);
 
-                // show window and bring it to front
-                metaWindow->show();
-                metaWindow->raise();
-                QApplication::setActiveWindow(metaWindow);
+                this->metaEditors[objEntry->getObjectFullPath()] = metaWindow;
             }
+
+            // show window and bring it to front
+            metaWindow->show();
+            metaWindow->raise();
+            QApplication::setActiveWindow(metaWindow);
         }
     }
 }
 
+void RodsMainWindow::doCollTableOpen()
+{
+    std::string collPath = this->getCurrentRodsCollPath();
+    RodsCollTableWindow *tableWindow = NULL;
+
+    // if we already don't have a table window for the collection, make one
+    if (this->collTables.find(collPath) != this->collTables.end())
+        tableWindow = this->collTables.at(collPath);
+
+    else {
+        tableWindow = new RodsCollTableWindow(this->conn, collPath);
+
+        connect(tableWindow, &RodsCollTableWindow::unregister, this,
+                &RodsMainWindow::unregisterCollTableWindow);
+        connect(tableWindow, &RodsCollTableWindow::selectObj, this,
+                &RodsMainWindow::selectRodsObject);
+
+        this->collTables[collPath] = tableWindow;
+    }
+
+    // show window and bring it to front
+    tableWindow->show();
+    tableWindow->raise();
+    QApplication::setActiveWindow(tableWindow);
+}
+
 void RodsMainWindow::doDownload()
 {
     QModelIndex curIndex = this->ui->rodsObjTree->currentIndex();
-    QStringList destPathSelection;
     std::string destPath;
 
     if (curIndex.isValid())
     {
-        RodsObjTreeItem *selection = static_cast<RodsObjTreeItem*>(curIndex.internalPointer());
-        Kanki::RodsObjEntryPtr objEntry = selection->getObjEntryPtr();
+        Kanki::RodsObjEntryPtr objEntry = this->objEntryAtIndex(curIndex);
 
         if (objEntry)
         {
-            QFileDialog destSelection(this, "Select Destination Directory");
-            destSelection.setFileMode(QFileDialog::Directory);
-            destSelection.setViewMode(QFileDialog::Detail);
-            destSelection.setLabelText(QFileDialog::Accept, "Destination");
-
-            // get destination from selection dialog
-            if (destSelection.exec())
-                destPathSelection = destSelection.selectedFiles();
-
             // if user cancelled
-            if (!destPathSelection.count())
+            if (!this->promptDownload(&destPath))
                 return;
 
             // create worker thread for downloading
             RodsDownloadThread *downloadWorker = new RodsDownloadThread(this->conn,
                                                                         objEntry,
-                                                                        destPathSelection.at(0).toStdString(),
+                                                                        destPath,
                                                                         this->verifyChecksum,
                                                                         this->allowOverwrite);
 
-            QString title = QString("Downloading '") + objEntry->getObjectName().c_str() + "'";
-            RodsTransferWindow *transferWindow = new RodsTransferWindow(title);
-
-            // connect worker thread signals to transfer window slots
-            connect(downloadWorker, &RodsDownloadThread::setupProgressDisplay, transferWindow,
-                    &RodsTransferWindow::setupMainProgressBar);
-            connect(downloadWorker, &RodsDownloadThread::progressUpdate, transferWindow,
-                    &RodsTransferWindow::updateMainProgress);
-            connect(downloadWorker, &RodsDownloadThread::setupSubProgressDisplay, transferWindow,
-                    &RodsTransferWindow::setupSubProgressBar);
-            connect(downloadWorker, &RodsDownloadThread::subProgressUpdate, transferWindow,
-                    &RodsTransferWindow::updateSubProgress);
-            connect(downloadWorker, &RodsDownloadThread::progressMarquee, transferWindow,
-                    &RodsTransferWindow::progressMarquee);
-
-            // error reporting signal connects to the error log window slot
-            connect(downloadWorker, &RodsDownloadThread::reportError, this->errorLogWindow,
-                    &RodsErrorLogWindow::logError);
-
-            // connect thread finished signal to Qt object deletion mechanisms
-            connect(downloadWorker, &RodsDownloadThread::finished,
-                    &QObject::deleteLater);
-            connect(downloadWorker, &RodsDownloadThread::finished, transferWindow,
-                    &QObject::deleteLater);
-
-            // we use a brute force terminate signal for now
-            connect(transferWindow, &RodsTransferWindow::cancelRequested, downloadWorker,
-                    &QThread::terminate);
-
-            transferWindow->show();
-            transferWindow->raise();
-            QApplication::setActiveWindow(transferWindow);
-
-            // start worker thread
-            downloadWorker->start();
+            this->startDownload(downloadWorker, QString("Downloading '") + objEntry->getObjectName().c_str() + "'");
         }
     }
 }
 
+void RodsMainWindow::downloadObjects(const Kanki::RodsObjGroups &objs)
+{
+    std::string destPath;
+
+    if (!this->promptDownload(&destPath))
+        return;
+
+    // all the objects are downloaded in one job with a single progress display
+    RodsDownloadThread *downloadWorker = new RodsDownloadThread(this->conn, objs, destPath,
+                                                                this->verifyChecksum, this->allowOverwrite);
+
+    this->startDownload(downloadWorker, "Downloading search results");
+}
+
+bool RodsMainWindow::promptDownload(std::string *destPath)
+{
+    QStringList destPathSelection;
+
+    QFileDialog destSelection(this, "Select Destination Directory");
+    destSelection.setFileMode(QFileDialog::Directory);
+    destSelection.setViewMode(QFileDialog::Detail);
+    destSelection.setLabelText(QFileDialog::Accept, "Destination");
+
+    // get destination from selection dialog
+    if (destSelection.exec())
+        destPathSelection = destSelection.selectedFiles();
+
+    // if user cancelled
+    if (!destPathSelection.count())
+        return (false);
+
+    *destPath = destPathSelection.at(0).toStdString();
+
+    return (true);
+}
+
+void RodsMainWindow::startDownload(RodsDownloadThread *downloadWorker, const QString &title)
+{
+    RodsTransferWindow *transferWindow = new RodsTransferWindow(title);
+
+    // connect worker thread signals to transfer window slots
+    connect(downloadWorker, &RodsDownloadThread::setupProgressDisplay, transferWindow,
+            &RodsTransferWindow::setupMainProgressBar);
+    connect(downloadWorker, &RodsDownloadThread::progressUpdate, transferWindow,
+            &RodsTransferWindow::updateMainProgress);
+    connect(downloadWorker, &RodsDownloadThread::setupSubProgressDisplay, transferWindow,
+            &RodsTransferWindow::setupSubProgressBar);
+    connect(downloadWorker, &RodsDownloadThread::subProgressUpdate, transferWindow,
+            &RodsTransferWindow::updateSubProgress);
+    connect(downloadWorker, &RodsDownloadThread::progressMarquee, transferWindow,
+            &RodsTransferWindow::progressMarquee);
+
+    // error reporting signal connects to the error log window slot
+    connect(downloadWorker, &RodsDownloadThread::reportError, this->errorLogWindow,
+            &RodsErrorLogWindow::logError);
+
+    // connect thread finished signal to Qt object deletion mechanisms
+    connect(downloadWorker, &RodsDownloadThread::finished,
+            &QObject::deleteLater);
+    connect(downloadWorker, &RodsDownloadThread::finished, transferWindow,
+            &QObject::deleteLater);
+
+    // we use a brute force terminate signal for now
+    connect(transferWindow, &RodsTransferWindow::cancelRequested, downloadWorker,
+            &QThread::terminate);
+
+    transferWindow->show();
+    transferWindow->raise();
+    QApplication::setActiveWindow(transferWindow);
+
+    // start worker thread
+    downloadWorker->start();
+}
+
+void RodsMainWindow::doExport()
+{
+    std::string collPath = this->getCurrentRodsCollPath();
+    std::string destPath;
+    Kanki::RodsObjExport::Format format = Kanki::RodsObjExport::CSV;
+    bool withMetadata = false;
+
+    if (!this->promptExport("Export Collection Listing", &destPath, &format, &withMetadata))
+        return;
+
+    // the whole subtree is streamed into the file
+    RodsExportThread *exportWorker = new RodsExportThread(this->conn, collPath, destPath, format, withMetadata);
+
+    this->startExport(exportWorker, QString("Exporting '") + collPath.c_str() + "'");
+}
+
+void RodsMainWindow::exportObjects(const Kanki::RodsObjGroups &objs)
+{
+    std::string destPath;
+    Kanki::RodsObjExport::Format format = Kanki::RodsObjExport::CSV;
+    bool withMetadata = false;
+
+    if (!this->promptExport("Export Search Results", &destPath, &format, &withMetadata))
+        return;
+
+    RodsExportThread *exportWorker = new RodsExportThread(this->conn, objs, destPath, format, withMetadata);
+
+    this->startExport(exportWorker, "Exporting search results");
+}
+
+bool RodsMainWindow::promptExport(const QString &title, std::string *destPath, Kanki::RodsObjExport::Format *format,
+                                  bool *withMetadata)
+{
+    QString selectedFilter;
+
+    // get destination file and format from the save dialog
+    QString fileName = QFileDialog::getSaveFileName(this, title, QString(),
+                                                    "CSV files (*.csv);;JSON lines files (*.jsonl)",
+                                                    &selectedFilter);
+
+    // if user cancelled
+    if (fileName.isEmpty())
+        return (false);
+
+    *destPath = fileName.toStdString();
+    *format = selectedFilter.startsWith("JSON") ? Kanki::RodsObjExport::JSONLines : Kanki::RodsObjExport::CSV;
+
+    // metadata takes additional queries
+    *withMetadata = QMessageBox::question(this, title, "Include the metadata (AVUs) of the data objects?") ==
+                    QMessageBox::Yes;
+
+    return (true);
+}
+
+void RodsMainWindow::startExport(RodsExportThread *exportWorker, const QString &title)
+{
+    RodsTransferWindow *transferWindow = new RodsTransferWindow(title);
+
+    // connect worker thread signals to transfer window slots
+    connect(exportWorker, &RodsExportThread::setupProgressDisplay, transferWindow,
+            &RodsTransferWindow::setupMainProgressBar);
+    connect(exportWorker, &RodsExportThread::progressUpdate, transferWindow,
+            &RodsTransferWindow::updateMainProgress);
+    connect(exportWorker, &RodsExportThread::progressMarquee, transferWindow,
+            &RodsTransferWindow::progressMarquee);
+
+    // error reporting signal connects to the error log window slot
+    connect(exportWorker, &RodsExportThread::reportError, this->errorLogWindow,
+            &RodsErrorLogWindow::logError);
+
+    // connect thread finished signal to Qt object deletion mechanisms
+    connect(exportWorker, &RodsExportThread::finished,
+            &QObject::deleteLater);
+    connect(exportWorker, &RodsExportThread::finished, transferWindow,
+            &QObject::deleteLater);
+
+    // the export stops at the next page, keeping the rows exported so far
+    connect(transferWindow, &RodsTransferWindow::cancelRequested, exportWorker,
+            &RodsExportThread::cancel);
+
+    transferWindow->show();
+    transferWindow->raise();
+    QApplication::setActiveWindow(transferWindow);
+
+    // start worker thread
+    exportWorker->start();
+}
+
 void RodsMainWindow::doUpload(bool uploadDirectory)
 {
     QStringList fileNames;
@@ -490,8 +694,13 @@ void RodsMainWindow::doUpload(bool uploadDirectory)
             &RodsErrorLogWindow::logError);
 
     // refresh signal connects directly to object model refresh slot
-    connect(uploadWorker, &RodsUploadThread::refreshObjectModel, this->model,
-            &RodsObjTreeModel::refreshAtPath);
+    if (this->flatModel)
+        connect(uploadWorker, &RodsUploadThread::refreshObjectModel, this->flatModel,
+                &RodsObjFlatTreeModel::refreshAtPath);
+
+    else
+        connect(uploadWorker, &RodsUploadThread::refreshObjectModel, this->model,
+                &RodsObjTreeModel::refreshAtPath);
 
     // connect thread finished signal to Qt object deletion mechanisms
     connect(uploadWorker, &RodsUploadThread::finished, &QObject::deleteLater);
@@ -522,21 +731,21 @@ void RodsMainWindow::doRefreshTreeView(QModelIndex atIndex)
 
     // if no valid index (no selection), assume initial mount point
     if (!curIndex.isValid())
-        curIndex = this->model->index(0, 0, QModelIndex());
+        curIndex = this->objModel()->index(0, 0, QModelIndex());
 
-    // get object pointers for selected item and tree view model
-    RodsObjTreeItem *selection = static_cast<RodsObjTreeItem*>(curIndex.internalPointer());
+    // get object entry for selected item
+    Kanki::RodsObjEntryPtr selection = this->objEntryAtIndex(curIndex);
 
     // if item is a proper item
-    if (selection->getObjEntryPtr())
+    if (selection)
     {
         // if a collection was selected, refresh it
-        if (selection->getObjEntryPtr()->objType == COLL_OBJ_T)
+        if (selection->objType == COLL_OBJ_T)
             this->refreshObjectModelAtIndex(curIndex);
 
         // if a data object was selected, refresh parent collection
-        else if (selection->getObjEntryPtr()->objType == DATA_OBJ_T)
-            this->refreshObjectModelAtIndex(this->model->parent(curIndex));
+        else if (selection->objType == DATA_OBJ_T)
+            this->refreshObjectModelAtIndex(this->objModel()->parent(curIndex));
     }
 
     else
@@ -588,6 +797,16 @@ void RodsMainWindow::doRodsDisconnect()
         // disconnect from iRODS
         this->conn->disconnect();
 
+        // prefetcher is based on the connection, stop it
+        this->stopPrefetcher();
+
+        // collection tables refer to the connection, close them
+        for (std::map<std::string, RodsCollTableWindow*>::iterator i = this->collTables.begin();
+             i != this->collTables.end(); i++)
+            delete (i->second);
+
+        this->collTables.clear();
+
         // delete connection object
         delete(this->conn);
         this->conn = NULL;
@@ -644,17 +863,15 @@ void RodsMainWindow::doDelete()
     if (curIndex.isValid())
     {
         // get selected item from index
-        RodsObjTreeItem *selection = static_cast<RodsObjTreeItem*>(curIndex.internalPointer());
-        RodsObjTreeModel *model = static_cast<RodsObjTreeModel*>(this->ui->rodsObjTree->model());
+        Kanki::RodsObjEntryPtr itemData = this->objEntryAtIndex(curIndex);
+        QAbstractItemModel *model = this->objModel();
 
         // we do delete only for proper items
-        if (selection->getObjEntryPtr())
+        if (itemData)
         {
             QMessageBox confirm;
-            Kanki::RodsObjEntryPtr itemData = selection->getObjEntryPtr();
 
-            // we must also get the parent object for collection path
-            RodsObjTreeItem *parentItem = selection->parent();
+            // we must also get the parent index for collection path
             QModelIndex parent = curIndex.parent();
 
             // configure message box
@@ -701,7 +918,7 @@ void RodsMainWindow::doDelete()
                     return;
 
                 // sanity check
-                if (parentItem)
+                if (parent.isValid())
                 {
                     // get full object path for remove operation
                     std::string objPath = itemData->getObjectFullPath();
@@ -747,6 +964,19 @@ std::string RodsMainWindow::getCurrentRodsCollPath()
     if (!curIndex.isValid())
         currentCollPath = this->conn->rodsHome();
 
+    // the flat model constructs paths from the node names
+    else if (this->flatModel)
+    {
+        Kanki::RodsObjEntryPtr selection = this->flatModel->objEntry(curIndex);
+
+        // for a data object the current collection is its parent
+        if (selection && selection->objType == DATA_OBJ_T)
+            currentCollPath = selection->collPath;
+
+        else
+            currentCollPath = this->flatModel->objectPath(curIndex);
+    }
+
     else {
         // get selected item and its parent item
         RodsObjTreeItem *selection = static_cast<RodsObjTreeItem*>(curIndex.internalPointer());
@@ -772,11 +1002,34 @@ QModelIndex RodsMainWindow::getCurrentRodsObjIndex()
 
     // in the case there's no valid selection, index at first mount
     if (!index.isValid())
-        return (this->model->index(0, 0, QModelIndex()));
+        return (this->objModel()->index(0, 0, QModelIndex()));
 
     return (index);
 }
 
+QAbstractItemModel* RodsMainWindow::objModel() const
+{
+    if (this->flatModel)
+        return (this->flatModel);
+
+    return (this->model);
+}
+
+Kanki::RodsObjEntryPtr RodsMainWindow::objEntryAtIndex(const QModelIndex &index) const
+{
+    // invalid index has no object
+    if (!index.isValid())
+        return (Kanki::RodsObjEntryPtr());
+
+    // the flat model constructs entries from its node columns
+    if (this->flatModel)
+        return (this->flatModel->objEntry(index));
+
+    RodsObjTreeItem *item = static_cast<RodsObjTreeItem*>(index.internalPointer());
+
+    return (item->getObjEntryPtr());
+}
+
 void RodsMainWindow::showAbout()
 {
     QString versionStr = "Version: " VERSION "\n\n";
@@ -814,6 +1067,9 @@ void RodsMainWindow::refreshResources()
                                 "bundleResc");
 
     // try to execute genquery
+    // the resource list rarely changes, it may be answered from the cache for a while
+    rescQuery.setCacheTTL(300);
+
     if ((status = rescQuery.execute()) < 0)
         this->reportError("Error while refreshing available iRODS storage resources",
                          "iRODS GenQuery error", status);
@@ -892,6 +1148,10 @@ void RodsMainWindow::openFindWindow()
                 this, &RodsMainWindow::unregisterFindWindow);
         connect(this->findWindow, &RodsFindWindow::selectObj,
                 this, &RodsMainWindow::selectRodsObject);
+        connect(this->findWindow, &RodsFindWindow::exportObjs,
+                this, &RodsMainWindow::exportObjects);
+        connect(this->findWindow, &RodsFindWindow::downloadObjs,
+                this, &RodsMainWindow::downloadObjects);
     }
 
     // show and activate window
@@ -912,6 +1172,35 @@ void RodsMainWindow::unregisterFindWindow()
     }
 }
 
+void RodsMainWindow::startPrefetcher()
+{
+    // prefetching requires a connection and the item tree model, and a single prefetcher is enough
+    if (this->prefetcher || !this->conn || !this->model)
+        return;
+
+    this->prefetcher = new RodsPrefetchThread(this->conn);
+
+    connect(this->prefetcher, &RodsPrefetchThread::reportError, this, &RodsMainWindow::reportError);
+
+    // prefetch at the lowest priority to leave room for foreground work
+    this->model->setPrefetcher(this->prefetcher);
+    this->prefetcher->start(QThread::LowestPriority);
+}
+
+void RodsMainWindow::stopPrefetcher()
+{
+    // sanity check
+    if (this->prefetcher)
+    {
+        if (this->model)
+            this->model->setPrefetcher(NULL);
+
+        // thread object stops and waits for the thread on deletion
+        delete (this->prefetcher);
+        this->prefetcher = NULL;
+    }
+}
+
 void RodsMainWindow::selectRodsObject(QString objPath)
 {
 
@@ -962,6 +1251,11 @@ void RodsMainWindow::on_actionDownload_triggered()
     this->doDownload();
 }
 
+void RodsMainWindow::on_actionExport_triggered()
+{
+    this->doExport();
+}
+
 void RodsMainWindow::on_viewSize_valueChanged(int value)
 {
     this->ui->rodsObjTree->setIconSize(QSize(value, value));
@@ -1012,3 +1306,24 @@ void RodsMainWindow::on_actionFind_triggered()
 {
     this->openFindWindow();
 }
+
+void RodsMainWindow::on_actionCollTable_triggered()
+{
+    this->doCollTableOpen();
+}
+
+void RodsMainWindow::on_actionPrefetch_toggled(bool checked)
+{
+    if (checked)
+        this->startPrefetcher();
+
+    else
+        this->stopPrefetcher();
+}
+
+void RodsMainWindow::on_actionNameIndex_toggled(bool checked)
+{
+    // collections listed from now on are indexed, disabling drops the index
+    if (this->conn)
+        this->conn->nameIndex()->setEnabled(checked);
+}
@@ -49,10 +49,14 @@
 #include "rodsconnectthread.h"
 #include "rodsuploadthread.h"
 #include "rodsdownloadthread.h"
+#include "rodsexportthread.h"
 #include "rodsobjtreemodel.h"
+#include "rodsobjflattreemodel.h"
 #include "rodstransferwindow.h"
 #include "rodserrorlogwindow.h"
 #include "rodsfindwindow.h"
+#include "rodscolltablewindow.h"
+#include "rodsprefetchthread.h"
 #include "version.h"
 
 // Qt UI compiler namespace for generated classes
@@ -106,6 +110,9 @@ public slots:
     // Qt slot for unregistering a metadata editor window from the grid browser window.
     void unregisterMetadataWindow(std::string objPath);
 
+    // Qt slot for unregistering a collection table window from the grid browser window.
+    void unregisterCollTableWindow(std::string collPath);
+
     // Qt slot for unregistering the queue stat window from the grid browser window.
     void unregisterQueueWindow();
 
@@ -127,6 +134,9 @@ public slots:
     // Qt slot for invoking the open metadata editor gui operation.
     void doMetadataEditorOpen();
 
+    // Qt slot for invoking the open collection table window gui operation.
+    void doCollTableOpen();
+
     // Qt slot for invoking the upload gui operation.
     void doUpload(bool uploadDirectory = false);
 
@@ -145,6 +155,15 @@ public slots:
     // Qt slot for invoking the download gui operation.
     void doDownload();
 
+    // Qt slot for invoking the download of the given data objects as one job.
+    void downloadObjects(const Kanki::RodsObjGroups &objs);
+
+    // Qt slot for invoking the export of a listing of the current collection subtree.
+    void doExport();
+
+    // Qt slot for invoking the export of a listing of the given data objects.
+    void exportObjects(const Kanki::RodsObjGroups &objs);
+
     // Qt slot for showing an about dialog
     void showAbout();
 
@@ -166,6 +185,12 @@ public slots:
     // Qt slot for selecting an object in the browser window.
     void selectRodsObject(QString objPath);
 
+    // Qt slot for starting the speculative collection prefetcher for the object model.
+    void startPrefetcher();
+
+    // Qt slot for stopping the speculative collection prefetcher.
+    void stopPrefetcher();
+
 private slots:
 
     // qt slot which connects to connect action triggered signal
@@ -222,6 +247,18 @@ private slots:
     // qt slot which connects to find action triggered signal
     void on_actionFind_triggered();
 
+    // qt slot which connects to collection table action triggered signal
+    void on_actionCollTable_triggered();
+
+    // qt slot which connects to prefetch action toggled signal
+    void on_actionPrefetch_toggled(bool checked);
+
+    // qt slot which connects to name index action toggled signal
+    void on_actionNameIndex_toggled(bool checked);
+
+    // qt slot which connects to export action triggered signal
+    void on_actionExport_triggered();
+
 signals:
 
     // signal for requesting object model refresh
@@ -238,6 +275,26 @@ private:
     // gets the current rods object tree model index
     QModelIndex getCurrentRodsObjIndex();
 
+    // gets the object tree model in use, either the item tree model or the flat model
+    QAbstractItemModel* objModel() const;
+
+    // gets the rods object entry at an object tree model index, mount points have none
+    Kanki::RodsObjEntryPtr objEntryAtIndex(const QModelIndex &index) const;
+
+    // prompts the user for a download destination directory, returns false if the user cancelled
+    bool promptDownload(std::string *destPath);
+
+    // shows a transfer window for a download worker thread and starts it
+    void startDownload(RodsDownloadThread *downloadWorker, const QString &title);
+
+    // prompts the user for an export file, its format and whether to include metadata,
+    // returns false if the user cancelled
+    bool promptExport(const QString &title, std::string *destPath, Kanki::RodsObjExport::Format *format,
+                      bool *withMetadata);
+
+    // shows a transfer window for an export worker thread and starts it
+    void startExport(RodsExportThread *exportWorker, const QString &title);
+
     // instance of Qt UI compiler generated UI
     Ui::RodsMainWindow *ui;
 
@@ -256,15 +313,27 @@ private:
     // a container of metadata window object pointers
     std::map<std::string, RodsMetadataWindow*> metaEditors;
 
+    // a container of collection table window object pointers
+    std::map<std::string, RodsCollTableWindow*> collTables;
+
     // our object tree model instance
     RodsObjTreeModel *model;
 
+    // our flat object tree model instance, used instead of the item tree model with --flat-tree
+    RodsObjFlatTreeModel *flatModel;
+
+    // our speculative collection prefetcher instance
+    RodsPrefetchThread *prefetcher;
+
     // pointer to rods connection object
     Kanki::RodsConnection *conn;
 
     // settings from the gui
     bool verifyChecksum, allowOverwrite;
 
+    // setting from the command line, whether to use the flat object tree model
+    bool flatTree;
+
     // current selected resource
     std::string currentResc;
 };
@@ -0,0 +1,181 @@
+/**
+ * @file rodsmetadatabatch.cpp
+ * @brief Implementation of Kanki library class RodsMetadataBatch
+ *
+ * The Kanki class RodsMetadataBatch implements a batch loader for the
+ * iRODS AVU metadata of many objects with a few paged queries.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsMetadataBatch header
+#include "rodsmetadatabatch.h"
+
+namespace Kanki {
+
+// initialize static class constants
+const unsigned int RodsMetadataBatch::idBatchSize = 64;
+
+RodsMetadataBatch::RodsMetadataBatch(Kanki::RodsConnection *theConn)
+{
+    this->conn = theConn;
+}
+
+int RodsMetadataBatch::loadCollection(const std::string &collPath, bool recursive)
+{
+    int status = 0;
+
+    // data objects and subcollections directly in the collection
+    {
+        Kanki::RodsGenQuery dataQuery(this->conn);
+        dataQuery.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, collPath);
+
+        if ((status = this->loadDataObjs(&dataQuery)) < 0)
+            return (status);
+
+        Kanki::RodsGenQuery collQuery(this->conn);
+        collQuery.addQueryCondition(COL_COLL_PARENT_NAME, Kanki::RodsGenQuery::isEqual, collPath);
+
+        if ((status = this->loadColls(&collQuery)) < 0)
+            return (status);
+    }
+
+    // the rest of the subtree is below the immediate subcollections
+    if (recursive)
+    {
+        std::string prefix = collPath;
+
+        if (prefix.empty() || prefix.at(prefix.length() - 1) != '/')
+            prefix += "/";
+
+        Kanki::RodsGenQuery dataQuery(this->conn);
+        dataQuery.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isLike, Kanki::RodsGenQuery::escapeLike(prefix) + "%");
+
+        if ((status = this->loadDataObjs(&dataQuery)) < 0)
+            return (status);
+
+        Kanki::RodsGenQuery collQuery(this->conn);
+        collQuery.addQueryCondition(COL_COLL_PARENT_NAME, Kanki::RodsGenQuery::isLike, Kanki::RodsGenQuery::escapeLike(prefix) + "%");
+
+        if ((status = this->loadColls(&collQuery)) < 0)
+            return (status);
+    }
+
+    return (status);
+}
+
+int RodsMetadataBatch::loadDataIds(const std::vector<std::string> &dataIds)
+{
+    int status = 0;
+
+    // query the ids in batches to keep the conditions reasonably sized
+    for (unsigned int i = 0; i < dataIds.size(); i += RodsMetadataBatch::idBatchSize)
+    {
+        unsigned int end = std::min(i + RodsMetadataBatch::idBatchSize, (unsigned int)dataIds.size());
+        std::vector<std::string> batch(dataIds.begin() + i, dataIds.begin() + end);
+
+        Kanki::RodsGenQuery dataQuery(this->conn);
+        dataQuery.addQueryCondition(COL_D_DATA_ID, Kanki::RodsGenQuery::isIn, batch);
+
+        if ((status = this->loadDataObjs(&dataQuery)) < 0)
+            return (status);
+    }
+
+    return (status);
+}
+
+int RodsMetadataBatch::loadDataObjs(Kanki::RodsGenQuery *query)
+{
+    // the object path and its AVUs, one row per AVU
+    query->addQueryAttribute(COL_COLL_NAME);
+    query->addQueryAttribute(COL_DATA_NAME);
+    query->addQueryAttribute(COL_META_DATA_ATTR_NAME);
+    query->addQueryAttribute(COL_META_DATA_ATTR_VALUE);
+    query->addQueryAttribute(COL_META_DATA_ATTR_UNITS);
+
+    // results are stored page by page, without an intermediate result table
+    return (query->executeStreaming(boost::bind(&RodsMetadataBatch::storeDataObjPage, this, _1)));
+}
+
+int RodsMetadataBatch::loadColls(Kanki::RodsGenQuery *query)
+{
+    // the collection path and its AVUs, one row per AVU
+    query->addQueryAttribute(COL_COLL_NAME);
+    query->addQueryAttribute(COL_META_COLL_ATTR_NAME);
+    query->addQueryAttribute(COL_META_COLL_ATTR_VALUE);
+    query->addQueryAttribute(COL_META_COLL_ATTR_UNITS);
+
+    return (query->executeStreaming(boost::bind(&RodsMetadataBatch::storeCollPage, this, _1)));
+}
+
+bool RodsMetadataBatch::storeDataObjPage(const RodsGenQuery::Page &page)
+{
+    std::string objPath;
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        Kanki::RodsObjMetadata::AVU avu;
+
+        // columns are in the order of the query attributes
+        objPath = page.value(i, 0);
+
+        if (objPath.empty() || objPath.at(objPath.length() - 1) != '/')
+            objPath += "/";
+
+        objPath += page.value(i, 1);
+
+        avu.name = page.value(i, 2);
+        avu.value = page.value(i, 3);
+        avu.unit = page.value(i, 4);
+
+        this->objAVUs[objPath].push_back(avu);
+    }
+
+    return (true);
+}
+
+bool RodsMetadataBatch::storeCollPage(const RodsGenQuery::Page &page)
+{
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        Kanki::RodsObjMetadata::AVU avu;
+
+        avu.name = page.value(i, 1);
+        avu.value = page.value(i, 2);
+        avu.unit = page.value(i, 3);
+
+        this->objAVUs[page.value(i, 0)].push_back(avu);
+    }
+
+    return (true);
+}
+
+const RodsMetadataBatch::ObjAVUs& RodsMetadataBatch::objects() const
+{
+    return (this->objAVUs);
+}
+
+const Kanki::RodsObjMetadata::AVUs& RodsMetadataBatch::avus(const std::string &objPath) const
+{
+    RodsMetadataBatch::ObjAVUs::const_iterator i = this->objAVUs.find(objPath);
+
+    if (i == this->objAVUs.end())
+        return (this->noAVUs);
+
+    return (i->second);
+}
+
+void RodsMetadataBatch::fill(const std::string &objPath, Kanki::RodsObjMetadata *metadata) const
+{
+    metadata->assign(this->avus(objPath));
+}
+
+void RodsMetadataBatch::clear()
+{
+    this->objAVUs.clear();
+}
+
+} // namespace Kanki
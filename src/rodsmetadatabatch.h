@@ -0,0 +1,95 @@
+/**
+ * @file rodsmetadatabatch.h
+ * @brief Definition of Kanki library class RodsMetadataBatch
+ *
+ * The Kanki class RodsMetadataBatch implements a batch loader for the
+ * iRODS AVU metadata of many objects with a few paged queries.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSMETADATABATCH_H
+#define RODSMETADATABATCH_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// boost library headers
+#include <boost/unordered_map.hpp>
+#include <boost/bind.hpp>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsobjmetadata.h"
+#include "_rodsgenquery.h"
+
+namespace Kanki {
+
+class RodsMetadataBatch
+{
+public:
+
+    // Class local type for the loaded metadata, AVUs keyed by the full rods path of the object.
+    typedef boost::unordered_map<std::string, Kanki::RodsObjMetadata::AVUs> ObjAVUs;
+
+    // Constructor requires a pointer to a Kanki rods connection object.
+    RodsMetadataBatch(Kanki::RodsConnection *theConn);
+
+    // Loads the metadata of the data objects and subcollections in a collection, optionally of
+    // all the objects in the collection subtree. Returns rods api status code.
+    int loadCollection(const std::string &collPath, bool recursive = false);
+
+    // Loads the metadata of the data objects with the given data object ids, the ids are
+    // queried in batches. Returns rods api status code.
+    int loadDataIds(const std::vector<std::string> &dataIds);
+
+    // Interface for accessing the loaded metadata of all objects.
+    const RodsMetadataBatch::ObjAVUs& objects() const;
+
+    // Interface for accessing the loaded metadata of an object at a full rods path, objects
+    // without metadata have no AVUs.
+    const Kanki::RodsObjMetadata::AVUs& avus(const std::string &objPath) const;
+
+    // Fills a metadata object for an object at a full rods path from the loaded metadata.
+    void fill(const std::string &objPath, Kanki::RodsObjMetadata *metadata) const;
+
+    // Clears the loaded metadata.
+    void clear();
+
+private:
+
+    // adds the metadata of the data objects matching the conditions of a query
+    int loadDataObjs(Kanki::RodsGenQuery *query);
+
+    // adds the metadata of the collections matching the conditions of a query
+    int loadColls(Kanki::RodsGenQuery *query);
+
+    // adds the data object metadata from a page of query results
+    bool storeDataObjPage(const RodsGenQuery::Page &page);
+
+    // adds the collection metadata from a page of query results
+    bool storeCollPage(const RodsGenQuery::Page &page);
+
+    // count of data object ids in a single query
+    static const unsigned int idBatchSize;
+
+    // pointer to Kanki rods connection object
+    Kanki::RodsConnection *conn;
+
+    // loaded metadata
+    RodsMetadataBatch::ObjAVUs objAVUs;
+
+    // empty AVU list for objects without metadata
+    Kanki::RodsObjMetadata::AVUs noAVUs;
+};
+
+} // namespace Kanki
+
+#endif // RODSMETADATABATCH_H
@@ -14,21 +14,26 @@
 // application class RodsMetadataConditionWidget header
 #include "rodsmetadataconditionwidget.h"
 
-RodsMetadataConditionWidget::RodsMetadataConditionWidget(objType_t type, const std::map<std::string, std::string> &attrs,
-                                                         QWidget *parent) :
+// initialize static class constants
+const int RodsMetadataConditionWidget::valuePageSize = 100;
+
+RodsMetadataConditionWidget::RodsMetadataConditionWidget(objType_t type, const Kanki::RodsMetadataFacets::Facets &attrs,
+                                                         Kanki::RodsMetadataFacets *facetQuery,
+                                                         const RodsMetadataSchema *schema, QWidget *parent) :
      RodsStringConditionWidget(type == DATA_OBJ_T ? COL_META_DATA_ATTR_VALUE : COL_META_COLL_ATTR_VALUE,
                                type == DATA_OBJ_T ? "Data Object Metadata Attribute" : "Collection Metadata Attribute", parent)
 {
     this->objType = type;
-    this->attrMap = attrs;
+    this->facets = facetQuery;
+    this->valueCount = 0;
 
     this->attrSel = new QComboBox(this);
 
-    for (std::map<std::string,std::string>::iterator i = this->attrMap.begin();
-         i != this->attrMap.end(); i++)
+    // attributes as counted by the server, the most common first
+    for (unsigned int i = 0; i < attrs.size(); i++)
     {
-        std::string attrName = i->first;
-        std::string attrLabel = i->second;
+        std::string attrName = attrs.at(i).name;
+        std::string attrLabel = schema->translateName(attrName);
         std::string label;
 
         if (attrName.compare(attrLabel))
@@ -37,17 +42,100 @@ RodsMetadataConditionWidget::RodsMetadataConditionWidget(objType_t type, const s
         else
             label = attrName;
 
+        label += " (" + QVariant(attrs.at(i).count).toString().toStdString() + ")";
+
         this->attrSel->addItem(label.c_str(), attrName.c_str());
     }
 
     this->layout->insertWidget (2, this->attrSel);
+
+    this->valueSel = new QComboBox(this);
+    this->layout->addWidget(this->valueSel);
+
+    connect(this->attrSel, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &RodsMetadataConditionWidget::attrSelected);
+    connect(this->valueSel, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated),
+            this, &RodsMetadataConditionWidget::valueSelected);
+
+    this->attrSelected(this->attrSel->currentIndex());
 }
 
 RodsMetadataConditionWidget::~RodsMetadataConditionWidget()
 {
+    delete (this->valueSel);
     delete (this->attrSel);
 }
 
+void RodsMetadataConditionWidget::attrSelected(int index)
+{
+    this->valueSel->clear();
+    this->valueSel->addItem("Values...");
+    this->valueSel->setDisabled(false);
+    this->valueCount = 0;
+
+    if (index >= 0)
+        this->loadValues();
+}
+
+void RodsMetadataConditionWidget::valueSelected(int index)
+{
+    // the first item is the title of the list
+    if (index <= 0)
+        return;
+
+    // the item after the values lists more of them
+    if (index > this->valueCount)
+    {
+        this->loadValues();
+        this->valueSel->showPopup();
+
+        return;
+    }
+
+    this->valueField->setText(this->valueSel->itemData(index).toString());
+    this->condBox->setCurrentIndex(this->condBox->findData(RodsStringConditionWidget::Equals));
+    this->valueSel->setCurrentIndex(0);
+}
+
+void RodsMetadataConditionWidget::loadValues()
+{
+    Kanki::RodsMetadataFacets::Facets values;
+    std::string attrName = this->attrSel->currentData().toString().toStdString();
+    int status = 0;
+
+    // values are counted by the server a page at a time
+    if ((status = this->facets->valueCounts(this->objType, attrName, &values, this->valueCount,
+                                            RodsMetadataConditionWidget::valuePageSize)) < 0)
+    {
+        // the value can still be entered by hand
+        this->valueSel->setItemText(0, "Values unavailable (" + QVariant(status).toString() + ")");
+        this->valueSel->setCurrentIndex(0);
+        this->valueSel->setDisabled(true);
+
+        return;
+    }
+
+    // the more item is replaced by the values
+    if (this->valueSel->count() > this->valueCount + 1)
+        this->valueSel->removeItem(this->valueSel->count() - 1);
+
+    for (unsigned int i = 0; i < values.size(); i++)
+    {
+        QString value = QString::fromStdString(values.at(i).name);
+        QString label = value + " (" + QVariant(values.at(i).count).toString() + ")";
+
+        this->valueSel->addItem(label, value);
+    }
+
+    this->valueCount += values.size();
+
+    // a full page suggests there are more values
+    if (values.size() == (size_t)RodsMetadataConditionWidget::valuePageSize)
+        this->valueSel->addItem("More...");
+
+    this->valueSel->setCurrentIndex(0);
+}
+
 void RodsMetadataConditionWidget::evaluateConds(Kanki::RodsGenQuery *query)
 {
     // attribute name condition
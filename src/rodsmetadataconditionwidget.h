@@ -30,10 +30,12 @@
 #include "rodsconnection.h"
 #include "rodsobjentry.h"
 #include "_rodsgenquery.h"
+#include "rodsmetadatafacets.h"
 
 // application headers
 #include "rodsconditionwidget.h"
 #include "rodsstringconditionwidget.h"
+#include "rodsmetadataschema.h"
 
 class RodsMetadataConditionWidget : public RodsStringConditionWidget
 {
@@ -41,8 +43,11 @@ class RodsMetadataConditionWidget : public RodsStringConditionWidget
 
 public:
 
-    //
-    RodsMetadataConditionWidget(objType_t type, const std::map<std::string, std::string> &attrs,
+    // constructor instantiates a widget for entering a metadata condition for objects of a type,
+    // the attributes are offered with their counts as queried by the caller, the values with
+    // their counts from the facet queries
+    RodsMetadataConditionWidget(objType_t type, const Kanki::RodsMetadataFacets::Facets &attrs,
+                                Kanki::RodsMetadataFacets *facetQuery, const RodsMetadataSchema *schema,
                                 QWidget *parent = 0);
 
     //
@@ -51,19 +56,36 @@ public:
     // evaluate genquery condition generated
     virtual void evaluateConds(Kanki::RodsGenQuery *query);
 
+private slots:
+
+    // Qt slot for listing the values of the selected attribute
+    void attrSelected(int index);
+
+    // Qt slot for entering a listed value, or for listing more values
+    void valueSelected(int index);
+
 private:
 
+    // appends the next page of values of the selected attribute into the value list
+    void loadValues();
+
+    // count of values listed at a time
+    static const int valuePageSize;
+
     // object type
     objType_t objType;
 
-    // available attributes
-    std::map<std::string, std::string> attrMap;
+    // facet queries for the attribute and value counts
+    Kanki::RodsMetadataFacets *facets;
+
+    // count of values listed for the selected attribute
+    int valueCount;
 
     // metadata attribute select
     QComboBox *attrSel;
 
-    // text field
-    QLineEdit *valueField;
+    // metadata value select, listing values with their counts
+    QComboBox *valueSel;
 };
 
 #endif // RODSMETADATACONDITIONWIDGET_H
@@ -0,0 +1,119 @@
+/**
+ * @file rodsmetadatafacets.cpp
+ * @brief Implementation of Kanki library class RodsMetadataFacets
+ *
+ * The Kanki class RodsMetadataFacets implements server side facet counts
+ * of iRODS AVU metadata, the counts of AVUs attached to objects by attribute
+ * name and by value of an attribute, counted by the catalog with aggregate
+ * GenQueries.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsMetadataFacets header
+#include "rodsmetadatafacets.h"
+
+namespace Kanki {
+
+RodsMetadataFacets::RodsMetadataFacets(Kanki::RodsConnection *theConn)
+{
+    this->conn = theConn;
+
+    // counts are good enough for a while, until metadata is changed
+    this->cacheTTL = 60;
+}
+
+void RodsMetadataFacets::setCacheTTL(int seconds)
+{
+    this->cacheTTL = seconds;
+}
+
+int RodsMetadataFacets::attributeCounts(objType_t objType, RodsMetadataFacets::Facets *facets)
+{
+    Kanki::RodsGenQuery query(this->conn);
+    int status = 0;
+
+    // the catalog counts the AVU rows grouped by attribute name
+    if (objType == COLL_OBJ_T)
+    {
+        query.addQueryAttribute(COL_META_COLL_ATTR_NAME);
+        query.addQueryAttribute(COL_COLL_ID, Kanki::RodsGenQuery::selectCount);
+    }
+
+    // a data object has a row for each replica, one replica is counted
+    else {
+        query.addQueryAttribute(COL_META_DATA_ATTR_NAME);
+        query.addQueryAttribute(COL_D_DATA_ID, Kanki::RodsGenQuery::selectCount);
+        query.addQueryCondition(COL_DATA_REPL_NUM, Kanki::RodsGenQuery::isEqual, 0);
+    }
+
+    facets->clear();
+
+    if ((status = this->executeCounts(&query, facets)) < 0)
+        return (status);
+
+    std::stable_sort(facets->begin(), facets->end(), RodsMetadataFacets::moreCommon);
+
+    return (status);
+}
+
+int RodsMetadataFacets::valueCounts(objType_t objType, const std::string &attrName, RodsMetadataFacets::Facets *facets,
+                                    int offset, int limit)
+{
+    Kanki::RodsGenQuery query(this->conn);
+
+    // the catalog counts the AVU rows of the attribute grouped by value, in value order for paging
+    if (objType == COLL_OBJ_T)
+    {
+        query.addQueryAttribute(COL_META_COLL_ATTR_VALUE, Kanki::RodsGenQuery::orderAscending);
+        query.addQueryAttribute(COL_COLL_ID, Kanki::RodsGenQuery::selectCount);
+        query.addQueryCondition(COL_META_COLL_ATTR_NAME, Kanki::RodsGenQuery::isEqual, attrName);
+    }
+
+    // a data object has a row for each replica, one replica is counted
+    else {
+        query.addQueryAttribute(COL_META_DATA_ATTR_VALUE, Kanki::RodsGenQuery::orderAscending);
+        query.addQueryAttribute(COL_D_DATA_ID, Kanki::RodsGenQuery::selectCount);
+        query.addQueryCondition(COL_META_DATA_ATTR_NAME, Kanki::RodsGenQuery::isEqual, attrName);
+        query.addQueryCondition(COL_DATA_REPL_NUM, Kanki::RodsGenQuery::isEqual, 0);
+    }
+
+    query.setRowOffset(offset);
+    query.setRowLimit(limit);
+
+    facets->clear();
+
+    return (this->executeCounts(&query, facets));
+}
+
+int RodsMetadataFacets::executeCounts(Kanki::RodsGenQuery *query, RodsMetadataFacets::Facets *facets)
+{
+    int status = 0;
+
+    query->setCacheTTL(this->cacheTTL);
+
+    if ((status = query->execute()) < 0)
+        return (status);
+
+    const Kanki::RodsQueryResult &result = query->result();
+
+    for (size_t i = 0; i < result.rowCount(); i++)
+    {
+        RodsMetadataFacets::Facet facet;
+        facet.name = result.cstr(i, 0);
+        facet.count = result.int64Value(i, 1);
+        facets->push_back(facet);
+    }
+
+    return (status);
+}
+
+bool RodsMetadataFacets::moreCommon(const RodsMetadataFacets::Facet &a, const RodsMetadataFacets::Facet &b)
+{
+    return (a.count > b.count);
+}
+
+} // namespace Kanki
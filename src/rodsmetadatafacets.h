@@ -0,0 +1,82 @@
+/**
+ * @file rodsmetadatafacets.h
+ * @brief Definition of Kanki library class RodsMetadataFacets
+ *
+ * The Kanki class RodsMetadataFacets implements server side facet counts
+ * of iRODS AVU metadata, the object counts by attribute name and by value
+ * of an attribute, counted by the catalog with aggregate GenQueries.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSMETADATAFACETS_H
+#define RODSMETADATAFACETS_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "_rodsgenquery.h"
+
+namespace Kanki {
+
+class RodsMetadataFacets
+{
+public:
+
+    // Class local public data structure for a facet, an attribute name or value and the count
+    // of its AVUs attached to objects, for data objects counted on one replica.
+    struct Facet {
+        std::string name;
+        rodsLong_t count;
+    };
+
+    // Class local public type for a list of facets.
+    typedef std::vector<RodsMetadataFacets::Facet> Facets;
+
+    // Constructor requires a pointer to a Kanki rods connection object.
+    RodsMetadataFacets(Kanki::RodsConnection *theConn);
+
+    // Sets the time in seconds facet counts may be answered from the query result cache,
+    // zero means every call queries the server.
+    void setCacheTTL(int seconds);
+
+    // Counts the AVUs attached to objects of a type (data objects or collections) by attribute
+    // name, the most common attributes first. An object with several values of an attribute is
+    // counted for each. Data objects are counted on replica number zero, not once per replica,
+    // so the few objects without one are left out. Returns rods api status code.
+    int attributeCounts(objType_t objType, RodsMetadataFacets::Facets *facets);
+
+    // Counts the AVUs attached to objects of a type by the values of an attribute as above, in
+    // value order, a page of at most limit values (zero means all) starting from offset.
+    // Returns rods api status code.
+    int valueCounts(objType_t objType, const std::string &attrName, RodsMetadataFacets::Facets *facets,
+                    int offset = 0, int limit = 0);
+
+private:
+
+    // executes a facet query and appends the counted names into a facet list
+    int executeCounts(Kanki::RodsGenQuery *query, RodsMetadataFacets::Facets *facets);
+
+    // orders facets by descending count
+    static bool moreCommon(const RodsMetadataFacets::Facet &a, const RodsMetadataFacets::Facet &b);
+
+    // pointer to Kanki rods connection object
+    Kanki::RodsConnection *conn;
+
+    // time in seconds facet counts may be answered from the cache
+    int cacheTTL;
+};
+
+} // namespace Kanki
+
+#endif // RODSMETADATAFACETS_H
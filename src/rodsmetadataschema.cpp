@@ -79,11 +79,15 @@ RodsMetadataSchema::RodsMetadataSchema(QString filePath)
                             QDomElement regExpRule = node.firstChildElement("irods:regExpRule");
                             QDomElement regExpFilter = node.firstChildElement("irods:regExpFilter");
 
-                            // if we have a proper rule
-                            if (regExpRule.text().length() > 0)
+                            QRegularExpression re(regExpRule.text());
+
+                            // if we have a proper rule, it is compiled once here instead of for every value
+                            if (regExpRule.text().length() > 0 && re.isValid())
                             {
-                                regExpRules[attrName.toStdString()] = regExpRule.text().toStdString();
-                                regExpFilters[attrName.toStdString()] = regExpFilter.text().toStdString();
+                                re.optimize();
+
+                                regExpRules[attrName.toStdString()] = re;
+                                regExpFilters[attrName.toStdString()] = regExpFilter.text();
                             }
                         }
                     }
@@ -109,14 +113,15 @@ std::string RodsMetadataSchema::translateName(const std::string &name) const
 
 std::string RodsMetadataSchema::filterValue(const std::string &name, const std::string &value) const
 {
-    QString valueStr = value.c_str();
+    std::map<std::string, QRegularExpression>::const_iterator rule = this->regExpRules.find(name);
 
-    // try to do regexp rule translation
-    if (this->regExpRules.find(name) != regExpRules.end())
-    {
-        QRegularExpression re(this->regExpRules.at(name).c_str());
-        valueStr.replace(re, regExpFilters.at(name).c_str());
-    }
+    // without a rule the value is returned as is
+    if (rule == this->regExpRules.end())
+        return (value);
+
+    // try to do regexp rule translation with the precompiled rule
+    QString valueStr = value.c_str();
+    valueStr.replace(rule->second, this->regExpFilters.at(name));
 
     return (valueStr.toStdString());
 }
@@ -66,11 +66,11 @@ private:
     // namespace prefix translate table
     std::map< std::string, std::string > nsConv;
 
-    // regexp rule table, has attribute name as key
-    std::map< std::string, std::string > regExpRules;
+    // regexp rule table, has attribute name as key, the rules are compiled on load
+    std::map< std::string, QRegularExpression > regExpRules;
 
     // regexp filter table, has attribute name as key
-    std::map< std::string, std::string > regExpFilters;
+    std::map< std::string, QString > regExpFilters;
 };
 
 #endif // RODSMETADATASCHEMA_H
@@ -0,0 +1,344 @@
+/**
+ * @file rodsnameindex.cpp
+ * @brief Implementation of Kanki library class RodsNameIndex
+ *
+ * The Kanki class RodsNameIndex implements a local trigram index of the
+ * names of iRODS objects, built from collection listings, for answering
+ * substring searches of object names without querying the server.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsNameIndex header
+#include "rodsnameindex.h"
+
+namespace Kanki {
+
+// initialize static class constants
+const size_t RodsNameIndex::minCompactCount = 1024;
+
+RodsNameIndex::RodsNameIndex()
+{
+    this->enabled = false;
+    this->removedCount = 0;
+}
+
+void RodsNameIndex::setEnabled(bool enabled)
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    this->enabled = enabled;
+
+    // a disabled index keeps nothing
+    if (!enabled)
+    {
+        this->entries.clear();
+        this->pathIds.clear();
+        this->collIds.clear();
+        this->postings.clear();
+        this->removedCount = 0;
+    }
+}
+
+bool RodsNameIndex::isEnabled() const
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    return (this->enabled);
+}
+
+void RodsNameIndex::indexCollection(const std::string &collPath, const std::vector<Kanki::RodsObjEntryPtr> &collObjs)
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+    std::vector<std::string> oldColls;
+
+    if (!this->enabled)
+        return;
+
+    boost::unordered_map<std::string, std::vector<unsigned int> >::iterator coll = this->collIds.find(collPath);
+
+    // the previous objects of the collection are replaced
+    if (coll != this->collIds.end())
+    {
+        for (unsigned int i = 0; i < coll->second.size(); i++)
+        {
+            RodsNameIndex::Entry &entry = this->entries.at(coll->second.at(i));
+
+            if (entry.path.empty())
+                continue;
+
+            if (entry.objType == COLL_OBJ_T)
+                oldColls.push_back(entry.path);
+
+            this->pathIds.erase(entry.path);
+            entry.path.clear();
+            this->removedCount++;
+        }
+
+        coll->second.clear();
+    }
+
+    else
+        this->collIds[collPath];
+
+    for (unsigned int i = 0; i < collObjs.size(); i++)
+        this->insertEntry(collObjs.at(i)->getObjectFullPath(), collObjs.at(i)->objType);
+
+    // subcollections gone from the listing take their indexed subtrees with them
+    for (unsigned int i = 0; i < oldColls.size(); i++)
+    {
+        if (!this->pathIds.count(oldColls.at(i)))
+            this->eraseObject(oldColls.at(i));
+    }
+
+    if (this->removedCount > RodsNameIndex::minCompactCount && this->removedCount * 2 > this->entries.size())
+        this->compact();
+}
+
+void RodsNameIndex::addObject(const std::string &objPath, objType_t objType)
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    if (this->enabled)
+        this->insertEntry(objPath, objType);
+}
+
+void RodsNameIndex::removeObject(const std::string &objPath)
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    if (this->enabled)
+        this->eraseObject(objPath);
+}
+
+bool RodsNameIndex::isIndexed(const std::string &collPath) const
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    return (this->collIds.count(collPath) > 0);
+}
+
+std::vector<RodsNameIndex::Entry> RodsNameIndex::search(const std::string &nameStr, objType_t objType,
+                                                        size_t maxResults, std::vector<std::string> *collPaths) const
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+    std::vector<RodsNameIndex::Entry> results;
+    std::vector<unsigned int> candidates;
+
+    // the results are complete for the indexed collections
+    if (collPaths)
+    {
+        collPaths->clear();
+
+        for (boost::unordered_map<std::string, std::vector<unsigned int> >::const_iterator i = this->collIds.begin();
+             i != this->collIds.end(); i++)
+            collPaths->push_back(i->first);
+    }
+
+    if (nameStr.empty())
+        return (results);
+
+    // names containing the string contain all of its trigrams
+    if (nameStr.length() >= 3)
+    {
+        std::vector<unsigned int> keys = RodsNameIndex::trigrams(nameStr);
+        std::vector<const std::vector<unsigned int>*> lists;
+
+        for (unsigned int i = 0; i < keys.size(); i++)
+        {
+            boost::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator posting =
+                    this->postings.find(keys.at(i));
+
+            if (posting == this->postings.end())
+                return (results);
+
+            lists.push_back(&posting->second);
+        }
+
+        // intersect starting from the shortest posting list
+        std::sort(lists.begin(), lists.end(), RodsNameIndex::shorterList);
+        candidates = *lists.front();
+
+        for (unsigned int i = 1; i < lists.size() && !candidates.empty(); i++)
+        {
+            std::vector<unsigned int> common;
+
+            std::set_intersection(candidates.begin(), candidates.end(), lists.at(i)->begin(), lists.at(i)->end(),
+                                  std::back_inserter(common));
+            candidates.swap(common);
+        }
+    }
+
+    // too short a string for trigrams, all objects are candidates
+    else {
+        for (unsigned int i = 0; i < this->entries.size(); i++)
+            candidates.push_back(i);
+    }
+
+    // the candidates are verified against the whole string
+    for (unsigned int i = 0; i < candidates.size(); i++)
+    {
+        const RodsNameIndex::Entry &entry = this->entries.at(candidates.at(i));
+
+        if (entry.path.empty() || (objType != UNKNOWN_OBJ_T && entry.objType != objType))
+            continue;
+
+        if (entry.path.find(nameStr, entry.path.find_last_of('/') + 1) == std::string::npos)
+            continue;
+
+        results.push_back(entry);
+
+        if (maxResults && results.size() >= maxResults)
+            break;
+    }
+
+    return (results);
+}
+
+size_t RodsNameIndex::size() const
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    return (this->pathIds.size());
+}
+
+void RodsNameIndex::clear()
+{
+    boost::unique_lock<boost::mutex> lock(this->indexMutex);
+
+    this->entries.clear();
+    this->pathIds.clear();
+    this->collIds.clear();
+    this->postings.clear();
+    this->removedCount = 0;
+}
+
+void RodsNameIndex::insertEntry(const std::string &objPath, objType_t objType)
+{
+    // replicas of a data object are listed separately, but indexed once
+    if (objPath.empty() || this->pathIds.count(objPath))
+        return;
+
+    boost::unordered_map<std::string, std::vector<unsigned int> >::iterator coll =
+            this->collIds.find(RodsNameIndex::parentPath(objPath));
+
+    // only the objects of indexed collections are indexed
+    if (coll == this->collIds.end())
+        return;
+
+    unsigned int id = this->entries.size();
+    RodsNameIndex::Entry entry;
+
+    entry.path = objPath;
+    entry.objType = objType;
+
+    this->entries.push_back(entry);
+    this->pathIds[objPath] = id;
+    coll->second.push_back(id);
+
+    // ids are appended in ascending order, keeping the posting lists sorted
+    std::vector<unsigned int> keys = RodsNameIndex::trigrams(objPath.substr(objPath.find_last_of('/') + 1));
+
+    for (unsigned int i = 0; i < keys.size(); i++)
+        this->postings[keys.at(i)].push_back(id);
+}
+
+void RodsNameIndex::eraseObject(const std::string &objPath)
+{
+    boost::unordered_map<std::string, unsigned int>::iterator obj = this->pathIds.find(objPath);
+    std::string prefix = objPath + "/";
+
+    // the posting lists are cleaned up by compaction
+    if (obj != this->pathIds.end())
+    {
+        this->entries.at(obj->second).path.clear();
+        this->pathIds.erase(obj);
+        this->removedCount++;
+    }
+
+    // a collection takes its indexed subtree with it
+    for (boost::unordered_map<std::string, std::vector<unsigned int> >::iterator i = this->collIds.begin();
+         i != this->collIds.end();)
+    {
+        if (i->first == objPath || !i->first.compare(0, prefix.length(), prefix))
+        {
+            for (unsigned int j = 0; j < i->second.size(); j++)
+            {
+                RodsNameIndex::Entry &entry = this->entries.at(i->second.at(j));
+
+                if (entry.path.empty())
+                    continue;
+
+                this->pathIds.erase(entry.path);
+                entry.path.clear();
+                this->removedCount++;
+            }
+
+            i = this->collIds.erase(i);
+        }
+
+        else
+            i++;
+    }
+}
+
+void RodsNameIndex::compact()
+{
+    std::vector<RodsNameIndex::Entry> oldEntries;
+
+    oldEntries.swap(this->entries);
+    this->pathIds.clear();
+    this->postings.clear();
+    this->removedCount = 0;
+
+    for (boost::unordered_map<std::string, std::vector<unsigned int> >::iterator i = this->collIds.begin();
+         i != this->collIds.end(); i++)
+        i->second.clear();
+
+    // reinserting in id order assigns new ascending ids
+    for (unsigned int i = 0; i < oldEntries.size(); i++)
+    {
+        if (!oldEntries.at(i).path.empty())
+            this->insertEntry(oldEntries.at(i).path, oldEntries.at(i).objType);
+    }
+}
+
+std::string RodsNameIndex::parentPath(const std::string &objPath)
+{
+    size_t pos = objPath.find_last_of('/');
+
+    if (pos == std::string::npos)
+        return (std::string());
+
+    // the parent of a top level collection is the root collection
+    if (!pos)
+        return ("/");
+
+    return (objPath.substr(0, pos));
+}
+
+std::vector<unsigned int> RodsNameIndex::trigrams(const std::string &name)
+{
+    std::vector<unsigned int> keys;
+
+    for (size_t i = 0; i + 3 <= name.length(); i++)
+    {
+        keys.push_back(((unsigned char)name.at(i) << 16) | ((unsigned char)name.at(i + 1) << 8) |
+                       (unsigned char)name.at(i + 2));
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    return (keys);
+}
+
+bool RodsNameIndex::shorterList(const std::vector<unsigned int> *a, const std::vector<unsigned int> *b)
+{
+    return (a->size() < b->size());
+}
+
+} // namespace Kanki
@@ -0,0 +1,126 @@
+/**
+ * @file rodsnameindex.h
+ * @brief Definition of Kanki library class RodsNameIndex
+ *
+ * The Kanki class RodsNameIndex implements a local trigram index of the
+ * names of iRODS objects, built from collection listings, for answering
+ * substring searches of object names without querying the server.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSNAMEINDEX_H
+#define RODSNAMEINDEX_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+// boost library headers
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsobjentry.h"
+
+namespace Kanki {
+
+class RodsNameIndex
+{
+public:
+
+    // Class local public data structure for an indexed object, its full rods path and type.
+    struct Entry {
+        std::string path;
+        objType_t objType;
+    };
+
+    // Constructor initializes an empty index, disabled until enabled.
+    RodsNameIndex();
+
+    // Enables or disables the index, a disabled index is cleared and ignores updates.
+    void setEnabled(bool enabled);
+
+    // Interface for querying whether the index is enabled.
+    bool isEnabled() const;
+
+    // Indexes the objects of a collection from its listing, replacing the previously indexed
+    // objects of the collection. Subcollections missing from the listing are removed with their
+    // subtrees. The collection is indexed after this.
+    void indexCollection(const std::string &collPath, const std::vector<Kanki::RodsObjEntryPtr> &collObjs);
+
+    // Adds an object at a full rods path into the index, if its parent collection is indexed.
+    void addObject(const std::string &objPath, objType_t objType);
+
+    // Removes an object at a full rods path from the index, for a collection also its subtree,
+    // which is no longer indexed after this.
+    void removeObject(const std::string &objPath);
+
+    // Interface for querying whether the objects of a collection are indexed.
+    bool isIndexed(const std::string &collPath) const;
+
+    // Searches the indexed objects of a type (any type for UNKNOWN_OBJ_T) with names containing
+    // a string, at most maxResults of them (zero means no limit). Optionally returns the paths of
+    // the collections searched, the results are complete for those collections only.
+    std::vector<RodsNameIndex::Entry> search(const std::string &nameStr, objType_t objType = UNKNOWN_OBJ_T,
+                                             size_t maxResults = 0, std::vector<std::string> *collPaths = NULL) const;
+
+    // Returns the count of indexed objects.
+    size_t size() const;
+
+    // Clears the index.
+    void clear();
+
+private:
+
+    // adds an entry for an object under an indexed collection, called with the mutex locked
+    void insertEntry(const std::string &objPath, objType_t objType);
+
+    // removes an object and for a collection its indexed subtree, called with the mutex locked
+    void eraseObject(const std::string &objPath);
+
+    // rebuilds the index without removed entries, called with the mutex locked
+    void compact();
+
+    // returns the parent collection path of an object path
+    static std::string parentPath(const std::string &objPath);
+
+    // returns the distinct trigram keys of an object name in ascending order
+    static std::vector<unsigned int> trigrams(const std::string &name);
+
+    // orders posting lists by their length
+    static bool shorterList(const std::vector<unsigned int> *a, const std::vector<unsigned int> *b);
+
+    // count of removed entries after which the index may be compacted
+    static const size_t minCompactCount;
+
+    // whether the index is enabled
+    bool enabled;
+
+    // indexed objects by id, removed entries have an empty path
+    std::vector<RodsNameIndex::Entry> entries;
+    size_t removedCount;
+
+    // object ids by full path, and the ids of the objects of each indexed collection
+    boost::unordered_map<std::string, unsigned int> pathIds;
+    boost::unordered_map<std::string, std::vector<unsigned int> > collIds;
+
+    // ascending object ids by the trigrams of their names
+    boost::unordered_map<unsigned int, std::vector<unsigned int> > postings;
+
+    // the index is updated from the threads listing collections
+    mutable boost::mutex indexMutex;
+};
+
+} // namespace Kanki
+
+#endif // RODSNAMEINDEX_H
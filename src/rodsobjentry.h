@@ -15,6 +15,8 @@
 
 // C++ standard library headers
 #include <string>
+#include <vector>
+#include <utility>
 
 // boost library headers
 #include "boost/shared_ptr.hpp"
@@ -62,6 +64,10 @@ public:
 
 typedef boost::shared_ptr<RodsObjEntry> RodsObjEntryPtr;
 
+// Type for a set of data objects by collection, the collection paths and the data object names
+// in them, as found by a search and handed to the export and download jobs.
+typedef std::vector<std::pair<std::string, std::vector<std::string> > > RodsObjGroups;
+
 } // namespace Kanki
 
 #endif // RODSOBJENTRY_H
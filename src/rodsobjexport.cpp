@@ -0,0 +1,336 @@
+/**
+ * @file rodsobjexport.cpp
+ * @brief Implementation of Kanki library class RodsObjExport
+ *
+ * The Kanki class RodsObjExport implements a streaming export of the
+ * attributes of iRODS data objects (and optionally their AVU metadata)
+ * into a CSV or JSON lines manifest, written page by page as the query
+ * results arrive.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsObjExport header
+#include "rodsobjexport.h"
+
+namespace Kanki {
+
+// initialize static class constants
+const unsigned int RodsObjExport::nameBatchSize = 64;
+
+RodsObjExport::RodsObjExport(Kanki::RodsConnection *theConn, std::ostream *theOut, RodsObjExport::Format theFormat,
+                             Kanki::RodsConnection *theMetaConn)
+{
+    this->conn = theConn;
+    this->metaConn = theMetaConn;
+    this->out = theOut;
+    this->format = theFormat;
+    this->headerWritten = false;
+    this->metaStatus = 0;
+    this->rows = 0;
+    this->cancelled = false;
+}
+
+int RodsObjExport::exportCollection(const std::string &collPath)
+{
+    int status = 0;
+    std::string prefix = collPath;
+
+    if (prefix.empty() || prefix.at(prefix.length() - 1) != '/')
+        prefix += "/";
+
+    // the data objects in the collection itself and below it
+    {
+        Kanki::RodsGenQuery query(this->conn);
+        query.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, collPath);
+
+        if ((status = this->exportDataObjs(&query)) < 0)
+            return (status);
+    }
+
+    Kanki::RodsGenQuery query(this->conn);
+    query.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isLike, Kanki::RodsGenQuery::escapeLike(prefix) + "%");
+
+    return (this->exportDataObjs(&query));
+}
+
+int RodsObjExport::exportObjects(const std::string &collPath, const std::vector<std::string> &dataNames)
+{
+    std::vector<std::vector<std::string> > batches =
+            Kanki::RodsGenQuery::makeValueBatches(dataNames, RodsObjExport::nameBatchSize);
+    int status = 0;
+
+    // the names are queried in batches of an in condition each
+    for (unsigned int i = 0; i < batches.size(); i++)
+    {
+        Kanki::RodsGenQuery query(this->conn);
+
+        query.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, collPath);
+        query.addQueryCondition(COL_DATA_NAME, Kanki::RodsGenQuery::isIn, batches.at(i));
+
+        if ((status = this->exportDataObjs(&query)) < 0)
+            return (status);
+    }
+
+    return (status);
+}
+
+void RodsObjExport::setProgressHandler(RodsObjExport::ProgressHandler handler)
+{
+    this->progressHandler = handler;
+}
+
+size_t RodsObjExport::rowCount() const
+{
+    boost::unique_lock<boost::mutex> lock(this->exportMutex);
+
+    return (this->rows);
+}
+
+void RodsObjExport::cancel()
+{
+    boost::unique_lock<boost::mutex> lock(this->exportMutex);
+
+    this->cancelled = true;
+}
+
+int RodsObjExport::exportDataObjs(Kanki::RodsGenQuery *query)
+{
+    int status = 0;
+
+    {
+        boost::unique_lock<boost::mutex> lock(this->exportMutex);
+
+        if (this->cancelled)
+            return (status);
+    }
+
+    if (!this->headerWritten)
+        this->writeHeader();
+
+    // columns are in the order of the query attributes
+    query->addQueryAttribute(COL_D_DATA_ID);
+    query->addQueryAttribute(COL_COLL_NAME);
+    query->addQueryAttribute(COL_DATA_NAME);
+    query->addQueryAttribute(COL_DATA_REPL_NUM);
+    query->addQueryAttribute(COL_D_RESC_NAME);
+    query->addQueryAttribute(COL_DATA_SIZE);
+    query->addQueryAttribute(COL_D_DATA_CHECKSUM);
+    query->addQueryAttribute(COL_D_CREATE_TIME);
+    query->addQueryAttribute(COL_D_MODIFY_TIME);
+
+    // rows are written page by page, only a page is held in memory at a time
+    if ((status = query->executeStreaming(boost::bind(&RodsObjExport::writePage, this, _1))) < 0)
+        return (status);
+
+    return (this->metaStatus);
+}
+
+bool RodsObjExport::writePage(const Kanki::RodsGenQuery::Page &page)
+{
+    Kanki::RodsMetadataBatch batch(this->metaConn);
+
+    {
+        boost::unique_lock<boost::mutex> lock(this->exportMutex);
+
+        if (this->cancelled)
+            return (false);
+    }
+
+    // the metadata of the page is queried in batches by data object id
+    if (this->metaConn)
+    {
+        std::vector<std::string> dataIds;
+
+        for (int i = 0; i < page.rowCount(); i++)
+            dataIds.push_back(page.value(i, 0));
+
+        if ((this->metaStatus = batch.loadDataIds(dataIds)) < 0)
+            return (false);
+    }
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        std::string objPath = page.value(i, 1);
+
+        if (objPath.empty() || objPath.at(objPath.length() - 1) != '/')
+            objPath += "/";
+
+        objPath += page.value(i, 2);
+
+        if (this->format == RodsObjExport::CSV)
+        {
+            *this->out << RodsObjExport::csvField(objPath);
+
+            for (int j = 3; j < 7; j++)
+                *this->out << "," << RodsObjExport::csvField(page.value(i, j));
+
+            // times as seconds since the epoch, without the padding
+            *this->out << "," << atol(page.value(i, 7)) << "," << atol(page.value(i, 8));
+
+            // AVUs are a single field of name=value(units) pairs separated by semicolons,
+            // the separators within the pairs escaped
+            if (this->metaConn)
+            {
+                const Kanki::RodsObjMetadata::AVUs &avus = batch.avus(objPath);
+                std::string avuStr;
+
+                for (unsigned int j = 0; j < avus.size(); j++)
+                {
+                    if (j)
+                        avuStr += ";";
+
+                    avuStr += RodsObjExport::avuPart(avus.at(j).name) + "=" + RodsObjExport::avuPart(avus.at(j).value);
+
+                    if (!avus.at(j).unit.empty())
+                        avuStr += "(" + RodsObjExport::avuPart(avus.at(j).unit) + ")";
+                }
+
+                *this->out << "," << RodsObjExport::csvField(avuStr);
+            }
+        }
+
+        else {
+            *this->out << "{\"path\":" << RodsObjExport::jsonString(objPath);
+            *this->out << ",\"replica\":" << atoi(page.value(i, 3));
+            *this->out << ",\"resource\":" << RodsObjExport::jsonString(page.value(i, 4));
+            *this->out << ",\"size\":" << atoll(page.value(i, 5));
+            *this->out << ",\"checksum\":" << RodsObjExport::jsonString(page.value(i, 6));
+            *this->out << ",\"created\":" << atol(page.value(i, 7));
+            *this->out << ",\"modified\":" << atol(page.value(i, 8));
+
+            if (this->metaConn)
+            {
+                const Kanki::RodsObjMetadata::AVUs &avus = batch.avus(objPath);
+
+                *this->out << ",\"metadata\":[";
+
+                for (unsigned int j = 0; j < avus.size(); j++)
+                {
+                    *this->out << (j ? ",{" : "{");
+                    *this->out << "\"name\":" << RodsObjExport::jsonString(avus.at(j).name);
+                    *this->out << ",\"value\":" << RodsObjExport::jsonString(avus.at(j).value);
+                    *this->out << ",\"units\":" << RodsObjExport::jsonString(avus.at(j).unit) << "}";
+                }
+
+                *this->out << "]";
+            }
+
+            *this->out << "}";
+        }
+
+        *this->out << "\n";
+    }
+
+    size_t rowsDone = 0;
+
+    {
+        boost::unique_lock<boost::mutex> lock(this->exportMutex);
+        rowsDone = this->rows += page.rowCount();
+    }
+
+    if (this->progressHandler)
+        this->progressHandler(rowsDone);
+
+    // an output error stops the export
+    return (this->out->good());
+}
+
+void RodsObjExport::writeHeader()
+{
+    if (this->format == RodsObjExport::CSV)
+    {
+        *this->out << "path,replica,resource,size,checksum,created,modified";
+
+        if (this->metaConn)
+            *this->out << ",metadata";
+
+        *this->out << "\n";
+    }
+
+    this->headerWritten = true;
+}
+
+std::string RodsObjExport::csvField(const std::string &str)
+{
+    // fields with separators, quotes or line breaks are quoted, with quotes doubled
+    if (str.find_first_of(",\"\r\n") == std::string::npos)
+        return (str);
+
+    std::string field = "\"";
+
+    for (unsigned int i = 0; i < str.length(); i++)
+    {
+        if (str.at(i) == '"')
+            field += "\"";
+
+        field += str.at(i);
+    }
+
+    return (field + "\"");
+}
+
+std::string RodsObjExport::avuPart(const std::string &str)
+{
+    // names, values and units may contain the separators of the pairs
+    if (str.find_first_of("\\;=()") == std::string::npos)
+        return (str);
+
+    std::string part;
+
+    for (unsigned int i = 0; i < str.length(); i++)
+    {
+        char c = str.at(i);
+
+        if (c == '\\' || c == ';' || c == '=' || c == '(' || c == ')')
+            part += '\\';
+
+        part += c;
+    }
+
+    return (part);
+}
+
+std::string RodsObjExport::jsonString(const std::string &str)
+{
+    std::string jsonStr = "\"";
+
+    for (unsigned int i = 0; i < str.length(); i++)
+    {
+        unsigned char c = str.at(i);
+
+        if (c == '"' || c == '\\')
+        {
+            jsonStr += '\\';
+            jsonStr += c;
+        }
+
+        else if (c == '\n')
+            jsonStr += "\\n";
+
+        else if (c == '\r')
+            jsonStr += "\\r";
+
+        else if (c == '\t')
+            jsonStr += "\\t";
+
+        // other control characters are escaped by code, utf-8 passes as is
+        else if (c < 0x20)
+        {
+            char escape[8];
+
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            jsonStr += escape;
+        }
+
+        else
+            jsonStr += c;
+    }
+
+    return (jsonStr + "\"");
+}
+
+} // namespace Kanki
@@ -0,0 +1,122 @@
+/**
+ * @file rodsobjexport.h
+ * @brief Definition of Kanki library class RodsObjExport
+ *
+ * The Kanki class RodsObjExport implements a streaming export of the
+ * attributes of iRODS data objects (and optionally their AVU metadata)
+ * into a CSV or JSON lines manifest, written page by page as the query
+ * results arrive.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSOBJEXPORT_H
+#define RODSOBJEXPORT_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+// boost library headers
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsobjmetadata.h"
+#include "rodsmetadatabatch.h"
+#include "_rodsgenquery.h"
+
+namespace Kanki {
+
+class RodsObjExport
+{
+public:
+
+    // Class local public enumerated type for the manifest formats.
+    enum Format { CSV, JSONLines };
+
+    // Class local public type for a progress handler, invoked with the count of rows exported
+    // after each page of results.
+    typedef boost::function<void (size_t rows)> ProgressHandler;
+
+    // Constructor requires a pointer to a Kanki rods connection object for the object queries,
+    // the output stream and the format. The AVUs of the objects are exported when a second
+    // connection is given for the metadata queries, the first one is busy while streaming.
+    // In CSV the AVUs are a single field of name=value(units) pairs separated by semicolons,
+    // with the characters \ ; = ( ) in names, values and units escaped by a backslash.
+    RodsObjExport(Kanki::RodsConnection *theConn, std::ostream *theOut, RodsObjExport::Format theFormat,
+                  Kanki::RodsConnection *theMetaConn = NULL);
+
+    // Exports the data objects in a collection subtree. Returns rods api status code.
+    int exportCollection(const std::string &collPath);
+
+    // Exports the named data objects in a collection, queried in batches. Returns rods api
+    // status code.
+    int exportObjects(const std::string &collPath, const std::vector<std::string> &dataNames);
+
+    // Sets the progress handler, invoked in the thread executing the export.
+    void setProgressHandler(RodsObjExport::ProgressHandler handler);
+
+    // Returns the count of rows (data object replicas) exported so far. Thread safe.
+    size_t rowCount() const;
+
+    // Cancels the export at the next page of results. Thread safe.
+    void cancel();
+
+private:
+
+    // exports the data objects matching the conditions of a query
+    int exportDataObjs(Kanki::RodsGenQuery *query);
+
+    // writes a page of query results, with their metadata queried on the second connection
+    bool writePage(const Kanki::RodsGenQuery::Page &page);
+
+    // writes the header line of a CSV manifest
+    void writeHeader();
+
+    // quotes a CSV field when necessary, and a JSON string
+    static std::string csvField(const std::string &str);
+    static std::string jsonString(const std::string &str);
+
+    // escapes the separators of the CSV metadata field in a name, value or units
+    static std::string avuPart(const std::string &str);
+
+    // count of data object names queried at a time
+    static const unsigned int nameBatchSize;
+
+    // pointers to Kanki rods connection objects, for the objects and their metadata
+    Kanki::RodsConnection *conn, *metaConn;
+
+    // output stream and format of the manifest
+    std::ostream *out;
+    RodsObjExport::Format format;
+    bool headerWritten;
+
+    // handler for reporting progress, if any
+    RodsObjExport::ProgressHandler progressHandler;
+
+    // status of the metadata queries, a failure stops the export
+    int metaStatus;
+
+    // progress and cancellation of the export, protected by the mutex
+    mutable boost::mutex exportMutex;
+    size_t rows;
+    bool cancelled;
+};
+
+} // namespace Kanki
+
+#endif // RODSOBJEXPORT_H
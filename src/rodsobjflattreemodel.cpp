@@ -0,0 +1,409 @@
+/**
+ * @file rodsobjflattreemodel.cpp
+ * @brief Implementation of class RodsObjFlatTreeModel
+ *
+ * The class RodsObjFlatTreeModel extends the Qt model class QAbstractItemModel
+ * and implements a read-only model for the iRODS object tree on top of
+ * the flattened node storage of RodsObjTreeStore.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsObjFlatTreeModel header
+#include "rodsobjflattreemodel.h"
+
+RodsObjFlatTreeModel::RodsObjFlatTreeModel(Kanki::RodsConnection *conn, const std::string &path, QObject *parent)
+    : QAbstractItemModel(parent)
+{
+    // set iRODS connection object pointer
+    rodsConn = conn;
+
+    // initialize icons
+    mountIcon = QIcon(":/tango/icons/folder-remote.png");
+    collIcon = QIcon(":/tango/icons/folder.png");
+    dataIcon = QIcon(":/tango/icons/text-x-generic.png");
+
+    // setup initial object tree model mount point
+    addMountPoint(path);
+}
+
+RodsObjTreeStore::NodeId RodsObjFlatTreeModel::nodeForIndex(const QModelIndex &index) const
+{
+    // invalid index refers to the root node
+    if (!index.isValid())
+        return (RodsObjTreeStore::RootNode);
+
+    // model indices carry the node id directly
+    return ((RodsObjTreeStore::NodeId)index.internalId());
+}
+
+QVariant RodsObjFlatTreeModel::data(const QModelIndex &index, int role) const
+{
+    // for an invalid index return empty data
+    if (!index.isValid())
+        return (QVariant());
+
+    RodsObjTreeStore::NodeId node = this->nodeForIndex(index);
+    objType_t objType = this->store.objType(node);
+
+    // if decoration data is being requested for column 0
+    if ((role == Qt::DecorationRole) && (index.column() == 0))
+    {
+        if (this->store.isMountPoint(node))
+            return (QVariant(mountIcon));
+
+        else if (objType == DATA_OBJ_T)
+            return (QVariant(dataIcon));
+
+        else if (objType == COLL_OBJ_T)
+            return (QVariant(collIcon));
+    }
+
+    // for display purposes we query the node columns
+    else if (role == Qt::DisplayRole)
+    {
+        // mount point nodes only have a path and a type
+        if (this->store.isMountPoint(node))
+        {
+            if (index.column() == 0)
+                return (QVariant(this->store.name(node)));
+
+            else if (index.column() == 1)
+                return (QVariant("Mount Point"));
+
+            else
+                return (QVariant("--"));
+        }
+
+        switch (index.column())
+        {
+            case 0:
+                return (QVariant(this->store.name(node)));
+
+            case 1:
+                return (QVariant(RodsObjTreeItem::formatTypeString(objType, this->store.name(node)).c_str()));
+
+            case 2:
+                if (objType == DATA_OBJ_T)
+                    return (QVariant(RodsObjTreeItem::formatSizeString(this->store.objSize(node))));
+
+                return (QVariant("--"));
+
+            case 3:
+                return (QVariant(RodsObjTreeItem::formatDateString(this->store.createTime(node)).c_str()));
+
+            case 4:
+                return (QVariant(RodsObjTreeItem::formatDateString(this->store.modifyTime(node)).c_str()));
+
+            case 5:
+                if (objType == DATA_OBJ_T)
+                    return (QVariant(this->store.replStatus(node) ? "Replicated" : "Not replicated"));
+
+                return (QVariant("--"));
+
+            case 6:
+                if (objType == DATA_OBJ_T)
+                {
+                    if (this->store.replStatus(node))
+                        return (QVariant(this->store.replNum(node)));
+
+                    return (QVariant("N/A"));
+                }
+
+                return (QVariant("--"));
+
+            default:
+            break;
+        }
+    }
+
+    return (QVariant());
+}
+
+Qt::ItemFlags RodsObjFlatTreeModel::flags(const QModelIndex &index) const
+{
+    // for an invalid index we return no flags
+    if (!index.isValid())
+        return (0);
+
+    // by default, certain basic flags
+    Qt::ItemFlags ret = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+
+    // if we have a data object as a node, no children
+    if (this->store.objType(this->nodeForIndex(index)) == DATA_OBJ_T)
+        ret |= Qt::ItemNeverHasChildren;
+
+    return (ret);
+}
+
+QVariant RodsObjFlatTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    // if we have sufficient conditions for giving out header data
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole))
+        return (QVariant(RodsObjTreeItem::columnName(section)));
+
+    // by default, return empty variant object
+    return (QVariant());
+}
+
+QModelIndex RodsObjFlatTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+    // if there is no index, return an empty index object
+    if (!hasIndex(row, column, parent))
+        return (QModelIndex());
+
+    RodsObjTreeStore::NodeId childNode = this->store.child(this->nodeForIndex(parent), row);
+
+    // if there is a child node at the row, create new index to it
+    if (childNode != RodsObjTreeStore::InvalidNode)
+        return (createIndex(row, column, (quintptr)childNode));
+
+    return (QModelIndex());
+}
+
+QModelIndex RodsObjFlatTreeModel::parent(const QModelIndex &child) const
+{
+    if (!child.isValid())
+        return (QModelIndex());
+
+    RodsObjTreeStore::NodeId parentNode = this->store.parent(this->nodeForIndex(child));
+
+    // if parent is root, return empty index
+    if (parentNode == RodsObjTreeStore::RootNode || parentNode == RodsObjTreeStore::InvalidNode)
+        return (QModelIndex());
+
+    // by default, return new index for parent node
+    return (createIndex(this->store.row(parentNode), 0, (quintptr)parentNode));
+}
+
+int RodsObjFlatTreeModel::rowCount(const QModelIndex &parent) const
+{
+    // other columns besides 0 doesn't have rows in this index
+    if (parent.column() > 0)
+        return (0);
+
+    return (this->store.childCount(this->nodeForIndex(parent)));
+}
+
+int RodsObjFlatTreeModel::columnCount(const QModelIndex &parent) const
+{
+    (void)parent;
+
+    return (RodsObjTreeItem::numColumns);
+}
+
+bool RodsObjFlatTreeModel::hasChildren(const QModelIndex &parent) const
+{
+    RodsObjTreeStore::NodeId node = this->nodeForIndex(parent);
+
+    // root node and mount points have children by default
+    if (node == RodsObjTreeStore::RootNode || this->store.isMountPoint(node))
+        return (true);
+
+    // fetched collections are known to have children or not
+    if (this->store.isFetched(node))
+        return (this->store.childCount(node) > 0);
+
+    // for rods items only collections may have children
+    return (this->store.objType(node) == COLL_OBJ_T);
+}
+
+bool RodsObjFlatTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+    // index needs to be valid for lazy fetching
+    if (!parent.isValid())
+        return (false);
+
+    RodsObjTreeStore::NodeId node = this->nodeForIndex(parent);
+
+    // collections and mount points are fetched once
+    return (this->store.objType(node) == COLL_OBJ_T && !this->store.isFetched(node));
+}
+
+void RodsObjFlatTreeModel::fetchMore(const QModelIndex &parent)
+{
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QApplication::processEvents();
+
+    // refresh children
+    this->refreshAtIndex(parent);
+
+    QApplication::restoreOverrideCursor();
+}
+
+void RodsObjFlatTreeModel::refreshAtIndex(QModelIndex parent)
+{
+    if (!parent.isValid())
+        return;
+
+    RodsObjTreeStore::NodeId node = this->nodeForIndex(parent);
+
+    // if the node is a data object we have nothing to do
+    if (this->store.objType(node) != COLL_OBJ_T)
+        return;
+
+    std::vector<Kanki::RodsObjEntryPtr> rodsColl;
+    int status = 0;
+
+    // try to read the collection from rods
+    if ((status = rodsConn->readColl(this->store.fullPath(node), &rodsColl)) < 0)
+        return;
+
+    this->setListing(parent, rodsColl);
+}
+
+void RodsObjFlatTreeModel::setListing(const QModelIndex &parent, const std::vector<Kanki::RodsObjEntryPtr> &rodsColl)
+{
+    RodsObjTreeStore::NodeId node = this->nodeForIndex(parent);
+
+    // if there are children, remove them
+    if (this->store.childCount(node))
+    {
+        beginRemoveRows(parent, 0, this->store.childCount(node) - 1);
+        this->store.removeChildren(node);
+        endRemoveRows();
+    }
+
+    // let the view(s) know we are inserting into the model
+    if (rodsColl.size())
+        beginInsertRows(parent, 0, rodsColl.size() - 1);
+
+    // store the listing as one contiguous block of nodes
+    this->store.setChildren(node, rodsColl);
+
+    if (rodsColl.size())
+        endInsertRows();
+}
+
+bool RodsObjFlatTreeModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    // sanity check, valid index and rows required
+    if (!parent.isValid() || row < 0 || row + count > this->rowCount(parent))
+        return (false);
+
+    // the removed objects are gone from rods, a new listing leaves them out
+    this->refreshAtIndex(parent);
+
+    return (true);
+}
+
+void RodsObjFlatTreeModel::refreshAtPath(QString path)
+{
+    std::vector<RodsObjTreeStore::NodeId> nodes = this->resolvePathToNodes(path.toStdString());
+
+    // refresh the listed collections matching the path
+    for (std::vector<RodsObjTreeStore::NodeId>::iterator i = nodes.begin(); i != nodes.end(); i++)
+    {
+        if (this->store.isFetched(*i))
+            this->refreshAtIndex(this->indexForNode(*i));
+    }
+}
+
+std::vector<RodsObjTreeStore::NodeId> RodsObjFlatTreeModel::resolvePathToNodes(const std::string &path) const
+{
+    std::vector<RodsObjTreeStore::NodeId> nodes;
+    std::string key = path;
+
+    // normalize path, strip trailing slashes
+    while (key.length() > 1 && key.at(key.length() - 1) == '/')
+        key.erase(key.length() - 1);
+
+    for (int i = 0; i < this->store.childCount(RodsObjTreeStore::RootNode); i++)
+    {
+        RodsObjTreeStore::NodeId node = this->store.child(RodsObjTreeStore::RootNode, i);
+        std::string mountPath = this->store.name(node);
+
+        while (mountPath.length() > 1 && mountPath.at(mountPath.length() - 1) == '/')
+            mountPath.erase(mountPath.length() - 1);
+
+        // the path has to be the mount point or below it
+        if (key.compare(0, mountPath.length(), mountPath) ||
+            (key.length() > mountPath.length() && mountPath != "/" && key.at(mountPath.length()) != '/'))
+            continue;
+
+        size_t pos = mountPath.length();
+
+        // descend by the path components through the listed children
+        while (node != RodsObjTreeStore::InvalidNode && pos < key.length())
+        {
+            if (key.at(pos) == '/')
+                pos++;
+
+            size_t end = key.find('/', pos);
+            std::string component = key.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+            RodsObjTreeStore::NodeId found = RodsObjTreeStore::InvalidNode;
+
+            for (int j = 0; j < this->store.childCount(node) && found == RodsObjTreeStore::InvalidNode; j++)
+            {
+                RodsObjTreeStore::NodeId child = this->store.child(node, j);
+
+                if (this->store.objType(child) == COLL_OBJ_T && !component.compare(this->store.name(child)))
+                    found = child;
+            }
+
+            node = found;
+            pos = end == std::string::npos ? key.length() : end;
+        }
+
+        if (node != RodsObjTreeStore::InvalidNode)
+            nodes.push_back(node);
+    }
+
+    return (nodes);
+}
+
+QModelIndex RodsObjFlatTreeModel::indexForNode(RodsObjTreeStore::NodeId node) const
+{
+    // root node is the invalid index
+    if (node == RodsObjTreeStore::RootNode)
+        return (QModelIndex());
+
+    return (createIndex(this->store.row(node), 0, (quintptr)node));
+}
+
+void RodsObjFlatTreeModel::addMountPoint(const std::string &path)
+{
+    // signal view(s) that model is to be reset and commit
+    beginResetModel();
+
+    // reclaim storage freed by refreshes while node ids may change
+    if (this->store.garbageCount() > this->store.nodeCount())
+        this->store.compact();
+
+    this->store.addMountPoint(path);
+    endResetModel();
+}
+
+std::string RodsObjFlatTreeModel::objectPath(const QModelIndex &index) const
+{
+    return (this->store.fullPath(this->nodeForIndex(index)));
+}
+
+Kanki::RodsObjEntryPtr RodsObjFlatTreeModel::objEntry(const QModelIndex &index) const
+{
+    RodsObjTreeStore::NodeId node = this->nodeForIndex(index);
+
+    // mount points and the root are not proper rods objects
+    if (!index.isValid() || this->store.isMountPoint(node))
+        return (Kanki::RodsObjEntryPtr());
+
+    objType_t objType = this->store.objType(node);
+    std::string path = this->store.fullPath(node);
+
+    // collections are named by their full path, data objects by their name in the collection
+    std::string collPath = objType == COLL_OBJ_T ? path : this->store.fullPath(this->store.parent(node));
+    std::string objName = objType == COLL_OBJ_T ? path : this->store.name(node);
+
+    // a mount path may have been given with a trailing slash
+    while (collPath.length() > 1 && collPath.at(collPath.length() - 1) == '/')
+        collPath.erase(collPath.length() - 1);
+
+    return (Kanki::RodsObjEntryPtr(new Kanki::RodsObjEntry(objName, collPath,
+                                                           QVariant((qlonglong)this->store.createTime(node)).toString().toStdString(),
+                                                           QVariant((qlonglong)this->store.modifyTime(node)).toString().toStdString(),
+                                                           objType, this->store.replNum(node),
+                                                           this->store.replStatus(node), this->store.objSize(node))));
+}
@@ -0,0 +1,128 @@
+/**
+ * @file rodsobjflattreemodel.h
+ * @brief Definition of class RodsObjFlatTreeModel
+ *
+ * The class RodsObjFlatTreeModel extends the Qt model class QAbstractItemModel
+ * and implements a read-only model for the iRODS object tree on top of
+ * the flattened node storage of RodsObjTreeStore.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSOBJFLATTREEMODEL_H
+#define RODSOBJFLATTREEMODEL_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// Qt framework headers
+#include <QApplication>
+#include <QAbstractItemModel>
+#include <QIcon>
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsobjentry.h"
+
+// application headers
+#include "rodsobjtreestore.h"
+#include "rodsobjtreeitem.h"
+
+class RodsObjFlatTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor requires a Kanki rods conn pointer and an initial rods path.
+    RodsObjFlatTreeModel(Kanki::RodsConnection *conn, const std::string &path, QObject *parent = 0);
+
+    // Overrides superclass virtual function for querying rods object model data with
+    // respect to a model index reference for a given Qt role.
+    QVariant data(const QModelIndex &index, int role) const;
+
+    // Overrides superclass virtual function for querying flags
+    // given a model index reference, depending on the characteristics of the node.
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+
+    // Overrides superclass virtual function for querying header data for
+    // view display purposes, for a given section and orientation and Qt role.
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const;
+
+    // Overrides superclass virtual function for generating a Qt model index for
+    // a node at a given row and column with respect to a parent index.
+    QModelIndex index(int row, int column, const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for accessing a Qt model index for
+    // the parent of a given child node index.
+    QModelIndex parent(const QModelIndex &child) const;
+
+    // Overrides superclass virtual function for querying the row count of the model
+    // at a given parent node index.
+    int rowCount(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for querying the column count of the model.
+    int columnCount(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for querying whether the node at
+    // a given index has any children.
+    bool hasChildren(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for querying whether to execute the
+    // lazy loading of rods object model data.
+    bool canFetchMore(const QModelIndex &parent) const;
+
+    // Overrides superclass virtual function for executing the lazy loading of
+    // the rods object model data from irods to a given model index.
+    void fetchMore(const QModelIndex &parent);
+
+    // Overrides superclass virtual function for removing rows from the model. The children
+    // of a node are stored as one block, so the parent collection is listed again.
+    bool removeRows(int row, int count, const QModelIndex &parent);
+
+    // Interface for setting the children of a collection at a model index from a rods collection listing.
+    void setListing(const QModelIndex &parent, const std::vector<Kanki::RodsObjEntryPtr> &rodsColl);
+
+    // Interface for adding an additional rods mount point to the object model.
+    void addMountPoint(const std::string &path);
+
+    // Interface for accessing the full rods path of the object at a model index.
+    std::string objectPath(const QModelIndex &index) const;
+
+    // Constructs a rods object entry for the object at a model index, mount points have none.
+    Kanki::RodsObjEntryPtr objEntry(const QModelIndex &index) const;
+
+public slots:
+
+    // Interface for requesting the model to refresh at a certain index.
+    void refreshAtIndex(QModelIndex parent);
+
+    // Interface for requesting the model to refresh the collections listed for a rods path.
+    void refreshAtPath(QString path);
+
+private:
+
+    // gets the store node id of a model index
+    RodsObjTreeStore::NodeId nodeForIndex(const QModelIndex &index) const;
+
+    // gets the model index of a store node id
+    QModelIndex indexForNode(RodsObjTreeStore::NodeId node) const;
+
+    // finds the collection nodes listed for a rods path, one per mount point containing it
+    std::vector<RodsObjTreeStore::NodeId> resolvePathToNodes(const std::string &path) const;
+
+    // qt icon objects used in the model
+    QIcon mountIcon, collIcon, dataIcon;
+
+    // rods conn pointer
+    Kanki::RodsConnection *rodsConn;
+
+    // flattened node storage for the object tree
+    RodsObjTreeStore store;
+};
+
+#endif // RODSOBJFLATTREEMODEL_H
@@ -54,6 +54,9 @@ int RodsObjMetadata::refresh()
     if (this->objEntry->objType == DATA_OBJ_T)
         metaQuery.addQueryCondition(COL_COLL_NAME, Kanki::RodsGenQuery::isEqual, this->objEntry->collPath);
 
+    // recently viewed object metadata is answered from the cache until metadata is changed
+    metaQuery.setCacheTTL(30);
+
     // execute the genquery for object metadata
     if ((status = metaQuery.execute()) < 0)
     {
@@ -81,6 +84,16 @@ int RodsObjMetadata::refresh()
     return (0);
 }
 
+void RodsObjMetadata::assign(const RodsObjMetadata::AVUs &avus)
+{
+    // clear hashtables
+    this->attrValues.clear();
+    this->attrUnits.clear();
+
+    for (unsigned int i = 0; i < avus.size(); i++)
+        this->addToStore(avus.at(i).name, avus.at(i).value, avus.at(i).unit);
+}
+
 void RodsObjMetadata::addToStore(std::string name, std::string value, std::string unit)
 {
     this->addToKeyVals(&this->attrValues, name, value);
@@ -160,6 +173,9 @@ int RodsObjMetadata::addAttribute(std::string attrName, std::string attrValue, s
 
     // update internal structures
     else {
+        // cached metadata query results are stale
+        this->conn->queryCache()->invalidate(Kanki::RodsQueryCache::metadataScope);
+
         this->addToStore(attrName, attrValue, attrUnit);
     }
 
@@ -221,6 +237,9 @@ int RodsObjMetadata::modifyAttribute(std::string attrName, std::string valueStr,
 
     // update internal data structures accordingly
     else {
+        // cached metadata query results are stale
+        this->conn->queryCache()->invalidate(Kanki::RodsQueryCache::metadataScope);
+
         // take references to value and unit vectors
         std::vector<std::string> &values = this->attrValues[attrName];
         std::vector<std::string> &units = this->attrUnits[attrName];
@@ -278,6 +297,9 @@ int RodsObjMetadata::removeAttribute(std::string attrName, std::string valueStr,
 
     // update internal data structures
     else {
+        // cached metadata query results are stale
+        this->conn->queryCache()->invalidate(Kanki::RodsQueryCache::metadataScope);
+
         // take references to value and unit vectors
         std::vector<std::string> &values = this->attrValues[attrName];
         std::vector<std::string> &units = this->attrUnits[attrName];
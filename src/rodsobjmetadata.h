@@ -43,9 +43,21 @@ public:
     // Class local type for a Key Value struct with multiple values per key.
     typedef std::map< std::string, std::vector< std::string > > KeyVals;
 
+    // Class local type for a metadata attribute AVU triplet.
+    struct AVU {
+        std::string name, value, unit;
+    };
+
+    // Class local type for a list of AVU triplets.
+    typedef std::vector<RodsObjMetadata::AVU> AVUs;
+
     // Interface for refreshing the contents of the metadata object from the iRODS iCAT.
     int refresh();
 
+    // Interface for filling the contents of the metadata object from AVUs retrieved earlier,
+    // e.g. by a batch metadata loader, without querying the iRODS iCAT.
+    void assign(const RodsObjMetadata::AVUs &avus);
+
     // Interface for adding a metadata attribute AVU triplet to the metadata. Updates iRODS
     // iCAT and and if successful, updates metadata object internal storage to reflect the addition.
     // Returns rods api status code.
@@ -23,6 +23,11 @@ RodsObjTreeItem::RodsObjTreeItem(RodsObjTreeItem *parent)
 {
     parentItem = parent;
 
+    // nothing fetched or known of the children yet
+    childrenFetched = false;
+    childHint = -1;
+    sizeHint = 0;
+
     this->configureMountPoint();
 }
 
@@ -31,6 +36,11 @@ RodsObjTreeItem::RodsObjTreeItem(Kanki::RodsObjEntryPtr data, RodsObjTreeItem *p
     objEntry = data;
     parentItem = parent;
 
+    // nothing fetched or known of the children yet
+    childrenFetched = false;
+    childHint = -1;
+    sizeHint = 0;
+
     this->configureMountPoint();
 }
 
@@ -127,57 +137,19 @@ QVariant RodsObjTreeItem::data(int column) const
 
         else if (column == 1)
         {
-            // get pointer to extension part of object name string
-            const char *extPart = strrchr(objEntry->objName.c_str(), '.');
-
-            // string to describe object type
-            std::string objTypeStr;
-
-            if (objEntry->objType == DATA_OBJ_T)
-            {
-                objTypeStr = "Data Object";
-
-                // if we have a file extension, TODO: proper file ext handling
-                if (extPart)
-                {
-                    if (!strcmp(extPart, ".dcm"))
-                        objTypeStr += " (DICOM Image)";
-                }
-            }
-
-            else if (objEntry->objType == COLL_OBJ_T)
-            {
-                objTypeStr = "Collection";
-
-                // proof-of-concept, TODO: specifications of typed collections
-                if (extPart)
-                {
-                    if (!strcmp(extPart, ".study"))
-                        objTypeStr += " (Study)";
-                }
-            }
-
-            return (QVariant(objTypeStr.c_str()));
+            // describe object type
+            return (QVariant(formatTypeString(objEntry->objType, objEntry->objName).c_str()));
         }
 
         // object size
         else if (column == 2)
         {
             if (objEntry->objType == DATA_OBJ_T)
-            {
-                unsigned int tmp = objEntry->objSize;
-                unsigned int p = 0;
+                return (QVariant(formatSizeString(objEntry->objSize)));
 
-                // get order of magnitude in binary exponents
-                for (p = 0; tmp / 1024; p++)
-                    tmp = tmp / 1024;
-
-                // construct size string from floored down value
-                double order = floor(objEntry->objSize / pow(1024, p));
-                QString sizeStr = QVariant(order).toString() + " " + RodsObjTreeItem::binPrefixes[p] + "B";
-
-                return (QVariant(sizeStr));
-            }
+            // for collections the prefetched total size, if known
+            else if (childHint >= 0)
+                return (QVariant(formatSizeString(sizeHint)));
 
             else
                 return (QVariant("--"));
@@ -233,10 +205,14 @@ RodsObjTreeItem* RodsObjTreeItem::parent()
 std::string RodsObjTreeItem::formatDateString(std::string timeStampStr) const
 {
     // get time stamp from string (convert string to integer)
-    time_t timeStamp = (time_t)atoi(timeStampStr.c_str());
+    return (RodsObjTreeItem::formatDateString((time_t)atoi(timeStampStr.c_str())));
+}
+
+std::string RodsObjTreeItem::formatDateString(time_t timeStamp)
+{
+    char buffer[64];
 
     // get pointer to converted string using thread safe ctime_r
-    char *buffer = (char*)malloc(64);
     char *timeStrData = ctime_r(&timeStamp, buffer);
 
     // make new string object and sanitize (remove endline)
@@ -247,12 +223,98 @@ std::string RodsObjTreeItem::formatDateString(std::string timeStampStr) const
     return (timeStr);
 }
 
+std::string RodsObjTreeItem::formatTypeString(objType_t objType, const std::string &objName)
+{
+    // get pointer to extension part of object name string
+    const char *extPart = strrchr(objName.c_str(), '.');
+
+    // string to describe object type
+    std::string objTypeStr;
+
+    if (objType == DATA_OBJ_T)
+    {
+        objTypeStr = "Data Object";
+
+        // if we have a file extension, TODO: proper file ext handling
+        if (extPart)
+        {
+            if (!strcmp(extPart, ".dcm"))
+                objTypeStr += " (DICOM Image)";
+        }
+    }
+
+    else if (objType == COLL_OBJ_T)
+    {
+        objTypeStr = "Collection";
+
+        // proof-of-concept, TODO: specifications of typed collections
+        if (extPart)
+        {
+            if (!strcmp(extPart, ".study"))
+                objTypeStr += " (Study)";
+        }
+    }
+
+    return (objTypeStr);
+}
+
+QString RodsObjTreeItem::formatSizeString(rodsLong_t objSize)
+{
+    rodsLong_t tmp = objSize;
+    unsigned int p = 0;
+
+    // get order of magnitude in binary exponents
+    for (p = 0; tmp / 1024; p++)
+        tmp = tmp / 1024;
+
+    // construct size string from floored down value
+    double order = floor(objSize / pow(1024, p));
+    QString sizeStr = QVariant(order).toString() + " " + RodsObjTreeItem::binPrefixes[p] + "B";
+
+    return (sizeStr);
+}
+
+const char* RodsObjTreeItem::columnName(int column)
+{
+    // sanity check for column bounds
+    if (column < 0 || column >= numColumns)
+        return ("");
+
+    return (columnNames[column]);
+}
+
 Kanki::RodsObjEntryPtr RodsObjTreeItem::getObjEntryPtr()
 {
     // return pointer to rods object entry
     return (objEntry);
 }
 
+void RodsObjTreeItem::setFetched(bool isFetched)
+{
+    this->childrenFetched = isFetched;
+}
+
+bool RodsObjTreeItem::fetched() const
+{
+    return (this->childrenFetched);
+}
+
+void RodsObjTreeItem::setChildHints(int childCount, rodsLong_t totalSize)
+{
+    this->childHint = childCount;
+    this->sizeHint = totalSize;
+}
+
+int RodsObjTreeItem::childCountHint() const
+{
+    return (this->childHint);
+}
+
+rodsLong_t RodsObjTreeItem::totalSizeHint() const
+{
+    return (this->sizeHint);
+}
+
 bool RodsObjTreeItem::removeChildren(int position, int count)
 {
     if (position < 0 || position + count > childItems.size())
@@ -77,12 +77,44 @@ public:
     // Removes a given count of child items from the item at given row position.
     bool removeChildren(int position, int count);
 
+    // Sets whether the children of the item have been fetched from rods.
+    void setFetched(bool isFetched);
+
+    // Interface for querying whether the children of the item have been fetched from rods.
+    bool fetched() const;
+
+    // Sets the prefetched child count and total data size hints of a collection item. The count
+    // is of catalog rows, replicas of a data object count separately, so only a zero count is exact
+    // (empty collection). The size is of replica number zero of each data object.
+    void setChildHints(int childCount, rodsLong_t totalSize);
+
+    // Interface for querying the prefetched child count, negative when not known.
+    int childCountHint() const;
+
+    // Interface for querying the prefetched total data size of a collection item.
+    rodsLong_t totalSizeHint() const;
+
+    // Interface for querying the name of a data column, for header display purposes.
+    static const char* columnName(int column);
+
+    // Formats an object type description string for an object type and object name.
+    static std::string formatTypeString(objType_t objType, const std::string &objName);
+
+    // Formats an object size string with a binary prefix.
+    static QString formatSizeString(rodsLong_t objSize);
+
+    // Formats a date string from a unix time stamp.
+    static std::string formatDateString(time_t timeStamp);
+
+    // Number of data columns of the items.
+    static const int numColumns;
+
 private:
 
     // configures the item default mount point based on parent item
     void configureMountPoint();
 
-    // formats a date string from a unix time stamp
+    // formats a date string from a unix time stamp string
     std::string formatDateString(std::string timeStampStr) const;
 
     // iRODS mount point path of the item
@@ -97,10 +129,16 @@ private:
     // pointer to parent item
     RodsObjTreeItem *parentItem;
 
+    // whether the children have been fetched
+    bool childrenFetched;
+
+    // prefetched child count and total data size
+    int childHint;
+    rodsLong_t sizeHint;
+
     // static class constants for data column configuration
     static const char *columnNames[];
     static const char *binPrefixes[];
-    static const int numColumns;
 };
 
 #endif // RODSOBJTREEITEM_H
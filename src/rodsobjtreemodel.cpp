@@ -14,12 +14,18 @@
 // application class RodsObjTreeModel header
 #include "rodsobjtreemodel.h"
 
+// initialize static class constants
+const int RodsObjTreeModel::prefetchBudget = 4;
+
 RodsObjTreeModel::RodsObjTreeModel(Kanki::RodsConnection *conn, const std::string &path, QObject *parent)
     : QAbstractItemModel(parent)
 {
     // set iRODS connection object pointer
     rodsConn = conn;
 
+    // no prefetching by default
+    prefetcher = NULL;
+
     // create new root item (with null parent pointer)
     rootItem = new RodsObjTreeItem(NULL);
 
@@ -94,9 +100,15 @@ bool RodsObjTreeModel::setData(const QModelIndex &index, const QVariant &value,
             Kanki::RodsObjEntryPtr objEntry = item->getObjEntryPtr();
             int status = 0;
 
+            // the object path is about to change, drop the item from the path index
+            this->unindexItem(item);
+
             // try to rename rods object
             if ((status = this->rodsConn->renameObj(objEntry, value.toString().toStdString())) >= 0)
             {
+                // index the item with its new path
+                this->indexItem(item);
+
                 // in success we signal model data change
                 this->dataChanged(index, index);
 
@@ -108,6 +120,9 @@ bool RodsObjTreeModel::setData(const QModelIndex &index, const QVariant &value,
             }
 
             else {
+                // rename failed, restore the item into the path index
+                this->indexItem(item);
+
                 // report error via a message box
                 QMessageBox errMsg;
                 QString errStr = "iRODS API error in rods object model update: " + QVariant(status).toString();
@@ -257,6 +272,10 @@ bool RodsObjTreeModel::hasChildren(const QModelIndex &parent) const
         // get item object pointer
         RodsObjTreeItem *theItem = static_cast<RodsObjTreeItem*>(parent.internalPointer());
 
+        // fetched items are known to have children or not
+        if (theItem->fetched())
+            return (theItem->childCount() > 0);
+
         // mount points have children by default
         if (!theItem->getObjEntryPtr())
         {
@@ -268,8 +287,9 @@ bool RodsObjTreeModel::hasChildren(const QModelIndex &parent) const
             if (theItem->getObjEntryPtr()->objType == DATA_OBJ_T)
                 return (false);
 
+            // unless the collection is known to be empty
             else if (theItem->getObjEntryPtr()->objType == COLL_OBJ_T)
-                return (true);
+                return (theItem->childCountHint() != 0);
         }
     }
 
@@ -288,11 +308,7 @@ bool RodsObjTreeModel::canFetchMore(const QModelIndex &parent) const
         if (!theItem->getObjEntryPtr())
         {
             // we fetch if we haven't already
-            if (theItem->childCount())
-                return (false);
-
-            else
-                return (true);
+            return (!theItem->fetched());
         }
 
         else {
@@ -303,12 +319,8 @@ bool RodsObjTreeModel::canFetchMore(const QModelIndex &parent) const
             // for collection objects children are fetched all at once
             else if (theItem->getObjEntryPtr()->objType == COLL_OBJ_T)
             {
-                // if there are currently no children, allow a fetch
-                if (!theItem->childCount())
-                    return (true);
-
-                else
-                    return (false);
+                // if not fetched yet and not known to be empty, allow a fetch
+                return (!theItem->fetched() && theItem->childCountHint() != 0);
             }
         }
     }
@@ -319,6 +331,21 @@ bool RodsObjTreeModel::canFetchMore(const QModelIndex &parent) const
 
 void RodsObjTreeModel::fetchMore(const QModelIndex &parent)
 {
+    RodsObjTreeItem *item = static_cast<RodsObjTreeItem*>(parent.internalPointer());
+    Kanki::RodsObjEntryPtr entry = parent.isValid() ? item->getObjEntryPtr() : Kanki::RodsObjEntryPtr();
+
+    // if the collection was listed speculatively, use the listing without a round trip
+    if (this->prefetcher && entry && entry->objType == COLL_OBJ_T && !item->childCount())
+    {
+        std::vector<Kanki::RodsObjEntryPtr> rodsColl;
+
+        if (this->prefetcher->takeListing(entry->objName, &rodsColl))
+        {
+            this->insertListing(parent, item, entry->objName, rodsColl, false);
+            return;
+        }
+    }
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
     QApplication::processEvents();
 
@@ -342,6 +369,10 @@ bool RodsObjTreeModel::removeRows(int row, int count, const QModelIndex &parent)
             // sanity check, remove count has to be less than child count
             if (count <= theItem->childCount())
             {
+                // drop the removed items from the path index
+                for (int i = row; i < row + count && i < theItem->childCount(); i++)
+                    this->unindexItem(theItem->child(i));
+
                 // signal view that a remove operation is starting
                 beginRemoveRows(parent, row, row + count - 1);
 
@@ -379,6 +410,10 @@ void RodsObjTreeModel::refreshAtIndex(QModelIndex parent)
     {
         QApplication::processEvents();
 
+        // drop the children from the path index
+        for (int i = 0; i < item->childCount(); i++)
+            this->unindexItem(item->child(i));
+
         // signal view objects that model data is about to change
         beginRemoveRows(parent, 0, item->childCount()-1);
 
@@ -422,105 +457,274 @@ void RodsObjTreeModel::refreshAtIndex(QModelIndex parent)
     }
 
     else {
-        // if there is something to insert
-        if (rodsColl->size())
+        // a fresh listing replaces any prefetched one
+        if (this->prefetcher)
+            this->prefetcher->invalidate(collPath);
+
+        this->insertListing(parent, item, collPath, *rodsColl, true);
+    }
+
+    // delete temporary vector of pointers
+    delete rodsColl;
+}
+
+void RodsObjTreeModel::insertListing(const QModelIndex &parent, RodsObjTreeItem *item, const std::string &collPath,
+                                     const std::vector<Kanki::RodsObjEntryPtr> &rodsColl, bool withHints)
+{
+    // children are now known, even if there are none
+    item->setFetched(true);
+
+    // if there is something to insert
+    if (rodsColl.size())
+    {
+        // let the view(s) know we are inserting into the model
+        beginInsertRows(parent, 0, rodsColl.size() - 1);
+
+        // iterate through vector and add child items
+        for (std::vector<Kanki::RodsObjEntryPtr>::const_iterator i = rodsColl.begin(); i != rodsColl.end(); i++)
         {
-            // let the view(s) know we are inserting into the model
-            beginInsertRows(parent, 0, rodsColl->size());
+            Kanki::RodsObjEntryPtr collEntPtr = *i;
+            RodsObjTreeItem *child = new RodsObjTreeItem(collEntPtr, item);
 
-            // iterate through vector and add child items
-            std::vector<Kanki::RodsObjEntryPtr>::iterator theEnd = rodsColl->end();
+            item->appendChild(child);
+            this->indexItem(child);
+        }
 
-            for (std::vector<Kanki::RodsObjEntryPtr>::iterator i = rodsColl->begin(); i != theEnd; i++)
-            {
-                Kanki::RodsObjEntryPtr collEntPtr = *i;
-                RodsObjTreeItem *child = new RodsObjTreeItem(collEntPtr, item);
+        // prefetch child hints for the new subcollections
+        if (withHints)
+            this->prefetchChildHints(item, collPath);
 
-                item->appendChild(child);
-            }
+        // insert operation ended, process event queue
+        endInsertRows();
+        QApplication::processEvents();
+    }
+
+    // speculatively list the first few subcollections for the next expand
+    if (this->prefetcher)
+    {
+        int budget = RodsObjTreeModel::prefetchBudget;
 
-            // insert operation ended, process event queue
-            endInsertRows();
-            QApplication::processEvents();
+        for (int i = 0; i < item->childCount() && budget > 0; i++)
+        {
+            RodsObjTreeItem *child = item->child(i);
+            Kanki::RodsObjEntryPtr entry = child->getObjEntryPtr();
+
+            // skip data objects and collections known to be empty
+            if (entry && entry->objType == COLL_OBJ_T && child->childCountHint() != 0)
+            {
+                this->prefetcher->enqueue(entry->objName);
+                budget--;
+            }
         }
     }
+}
 
-    // delete temporary vector of pointers
-    delete rodsColl;
+void RodsObjTreeModel::setPrefetcher(RodsPrefetchThread *thePrefetcher)
+{
+    this->prefetcher = thePrefetcher;
 }
 
-void RodsObjTreeModel::refreshAtPath(QString path)
+int RodsObjTreeModel::prefetchChildHints(RodsObjTreeItem *item, const std::string &collPath)
 {
-    QModelIndex curIndex;
-    RodsObjTreeItem *curItem = this->rootItem;
-    std::string curPath, pathStr = path.toStdString();
-    boost::char_separator<char> separator("/");
-    boost::tokenizer< boost::char_separator<char> > tokens(pathStr, separator);
-
-    // iterate path tokens to find item
-    for (boost::tokenizer< boost::char_separator<char> >::iterator iter = tokens.begin();
-         iter != tokens.end(); iter++)
+    boost::unordered_map<std::string, int> childCounts;
+    boost::unordered_map<std::string, rodsLong_t> totalSizes;
+    std::string parentPath = collPath;
+    bool hasColls = false;
+    int status = 0;
+
+    // check whether there are any subcollections to prefetch for
+    for (int i = 0; i < item->childCount() && !hasColls; i++)
+        if (item->child(i)->getObjEntryPtr() && item->child(i)->getObjEntryPtr()->objType == COLL_OBJ_T)
+            hasColls = true;
+
+    if (!hasColls)
+        return (0);
+
+    // the catalog has collection names without trailing slashes, mount paths may have them
+    while (parentPath.length() > 1 && parentPath.at(parentPath.length() - 1) == '/')
+        parentPath.erase(parentPath.length() - 1);
+
+    // count and sum the data object rows of the subcollections, grouped by collection and
+    // replica number: all the rows tell apart the empty collections, and the sizes of replica
+    // number zero are the total size without counting the other replicas again
+    Kanki::RodsGenQuery dataQuery(this->rodsConn);
+
+    dataQuery.addQueryAttribute(COL_COLL_NAME);
+    dataQuery.addQueryAttribute(COL_DATA_REPL_NUM);
+    dataQuery.addQueryAttribute(COL_D_DATA_ID, Kanki::RodsGenQuery::selectCount);
+    dataQuery.addQueryAttribute(COL_DATA_SIZE, Kanki::RodsGenQuery::selectSum);
+    dataQuery.addQueryCondition(COL_COLL_PARENT_NAME, Kanki::RodsGenQuery::isEqual, parentPath);
+
+    if ((status = dataQuery.execute()) < 0)
+        return (status);
+
+    const Kanki::RodsQueryResult &dataResult = dataQuery.result();
+
+    // columns are in the order of the query attributes
+    for (size_t i = 0; i < dataResult.rowCount(); i++)
     {
-        curPath += "/" + *iter;
+        childCounts[dataResult.cstr(i, 0)] += dataResult.int64Value(i, 2);
 
-        for (int i = 0; i < curItem->childCount(); i++)
+        if (!dataResult.int64Value(i, 1))
+            totalSizes[dataResult.cstr(i, 0)] += dataResult.int64Value(i, 3);
+    }
+
+    // count the subcollections of the subcollections, grouped by parent collection,
+    // the parent name is constrained to exactly one level below the listed collection
+    Kanki::RodsGenQuery collQuery(this->rodsConn);
+    std::string prefix = parentPath;
+
+    if (prefix.empty() || prefix.at(prefix.length() - 1) != '/')
+        prefix += "/";
+
+    collQuery.addQueryAttribute(COL_COLL_PARENT_NAME);
+    collQuery.addQueryAttribute(COL_COLL_NAME, Kanki::RodsGenQuery::selectCount);
+    collQuery.addQueryCondition(COL_COLL_PARENT_NAME, Kanki::RodsGenQuery::isLike,
+                                Kanki::RodsGenQuery::escapeLike(prefix) + "%");
+    collQuery.addQueryCondition(COL_COLL_PARENT_NAME, Kanki::RodsGenQuery::isNotLike,
+                                Kanki::RodsGenQuery::escapeLike(prefix) + "%/%");
+
+    if ((status = collQuery.execute()) < 0)
+        return (status);
+
+    const Kanki::RodsQueryResult &collResult = collQuery.result();
+
+    for (size_t i = 0; i < collResult.rowCount(); i++)
+        childCounts[collResult.cstr(i, 0)] += collResult.int64Value(i, 1);
+
+    // set hints for the subcollection items, collections missing from results are empty
+    for (int i = 0; i < item->childCount(); i++)
+    {
+        RodsObjTreeItem *child = item->child(i);
+        Kanki::RodsObjEntryPtr entry = child->getObjEntryPtr();
+
+        if (entry && entry->objType == COLL_OBJ_T)
         {
-            RodsObjTreeItem *childItem = curItem->child(i);
-            Kanki::RodsObjEntryPtr objEntry = childItem->getObjEntryPtr();
+            std::string childPath = entry->objName;
 
-            // if we found an item matching path token, we break from loop
-            if (!objEntry || (objEntry->objType == COLL_OBJ_T && !objEntry->objName.compare(curPath)))
-            {
-                curItem = childItem;
-                curIndex = this->index(i, 0, curIndex);
+            while (childPath.length() > 1 && childPath.at(childPath.length() - 1) == '/')
+                childPath.erase(childPath.length() - 1);
 
-                break;
-            }
+            boost::unordered_map<std::string, int>::const_iterator count = childCounts.find(childPath);
+            boost::unordered_map<std::string, rodsLong_t>::const_iterator size = totalSizes.find(childPath);
+
+            child->setChildHints(count != childCounts.end() ? count->second : 0,
+                                 size != totalSizes.end() ? size->second : 0);
         }
     }
 
-    // if item is a proper item and its path matches, refresh it
-    if (curItem->getObjEntryPtr() && !curItem->getObjEntryPtr()->getObjectFullPath().compare(path.toStdString()))
-        this->refreshAtIndex(curIndex);
+    return (status);
+}
+
+void RodsObjTreeModel::refreshAtPath(QString path)
+{
+    // look up all the items loaded for the path
+    std::vector<RodsObjTreeItem*> items = this->resolvePathToItems(path.toStdString());
+
+    // refresh collections and mount points matching the path
+    for (std::vector<RodsObjTreeItem*>::iterator i = items.begin(); i != items.end(); i++)
+    {
+        RodsObjTreeItem *item = *i;
 
-    // if item is a mount point and its mount path matches, also refresh
-    else if (!curItem->mountPoint().compare(path.toStdString()))
-        this->refreshAtIndex(curIndex);
+        if (!item->getObjEntryPtr() || item->getObjEntryPtr()->objType == COLL_OBJ_T)
+            this->refreshAtIndex(this->indexForItem(item));
+    }
+
+    // a speculative listing of the path is stale from now on
+    if (this->prefetcher)
+        this->prefetcher->invalidate(path.toStdString());
 }
 
 Kanki::RodsObjEntryPtr RodsObjTreeModel::resolvePathToEntry(const std::string &path)
 {
-    QModelIndex curIndex;
-    RodsObjTreeItem *curItem = this->rootItem;
-    std::string curPath;
-    boost::char_separator<char> separator("/");
-    boost::tokenizer< boost::char_separator<char> > tokens(path, separator);
-
-    // iterate path tokens to find item
-    for (boost::tokenizer< boost::char_separator<char> >::iterator iter = tokens.begin();
-         iter != tokens.end(); iter++)
+    std::vector<RodsObjTreeItem*> items = this->resolvePathToItems(path);
+
+    // return the first proper rods object item for the path
+    for (std::vector<RodsObjTreeItem*>::iterator i = items.begin(); i != items.end(); i++)
     {
-        curPath += "/" + *iter;
+        if ((*i)->getObjEntryPtr())
+            return ((*i)->getObjEntryPtr());
+    }
 
-        for (int i = 0; i < curItem->childCount(); i++)
-        {
-            RodsObjTreeItem *childItem = curItem->child(i);
-            Kanki::RodsObjEntryPtr objEntry = childItem->getObjEntryPtr();
+    // by default, return an empty entry pointer
+    return (Kanki::RodsObjEntryPtr());
+}
 
-            // if we found an item matching path token, we break from loop
-            if (!objEntry || !objEntry->getObjectFullPath().compare(curPath))
-            {
-                curItem = childItem;
-                curIndex = this->index(i, 0, curIndex);
+std::vector<RodsObjTreeItem*> RodsObjTreeModel::resolvePathToItems(const std::string &path) const
+{
+    std::vector<RodsObjTreeItem*> items;
+    std::string key = path;
 
-                break;
-            }
-        }
+    // normalize path, strip trailing slashes
+    while (key.length() > 1 && key.at(key.length() - 1) == '/')
+        key.erase(key.length() - 1);
+
+    // take a copy of the matching items, refreshing one modifies the index
+    std::pair<PathIndex::const_iterator, PathIndex::const_iterator> range = this->pathIndex.equal_range(key);
+
+    for (PathIndex::const_iterator i = range.first; i != range.second; i++)
+        items.push_back(i->second);
+
+    return (items);
+}
+
+QModelIndex RodsObjTreeModel::indexForItem(RodsObjTreeItem *item) const
+{
+    // root item has no index
+    if (!item || item == this->rootItem)
+        return (QModelIndex());
+
+    return (createIndex(item->row(), 0, item));
+}
+
+std::string RodsObjTreeModel::itemPath(RodsObjTreeItem *item)
+{
+    std::string path;
+
+    // mount points are indexed by their mount path
+    if (!item->getObjEntryPtr())
+    {
+        path = item->mountPoint();
+
+        while (path.length() > 1 && path.at(path.length() - 1) == '/')
+            path.erase(path.length() - 1);
     }
 
-    return (curItem->getObjEntryPtr());
+    // rods object items by their full object path
+    else
+        path = item->getObjEntryPtr()->getObjectFullPath();
+
+    return (path);
+}
+
+void RodsObjTreeModel::indexItem(RodsObjTreeItem *item)
+{
+    this->pathIndex.insert(PathIndex::value_type(RodsObjTreeModel::itemPath(item), item));
+
+    // recurse to the children of the item
+    for (int i = 0; i < item->childCount(); i++)
+        this->indexItem(item->child(i));
 }
 
+void RodsObjTreeModel::unindexItem(RodsObjTreeItem *item)
+{
+    // first recurse to the children of the item
+    for (int i = 0; i < item->childCount(); i++)
+        this->unindexItem(item->child(i));
+
+    std::pair<PathIndex::iterator, PathIndex::iterator> range =
+            this->pathIndex.equal_range(RodsObjTreeModel::itemPath(item));
+
+    // erase only the entry pointing to this very item
+    for (PathIndex::iterator i = range.first; i != range.second; i++)
+    {
+        if (i->second == item)
+        {
+            this->pathIndex.erase(i);
+            break;
+        }
+    }
+}
 
 Qt::DropActions RodsObjTreeModel::supportedDropActions() const
 {
@@ -568,15 +772,24 @@ bool RodsObjTreeModel::dropMimeData(const QMimeData *data, Qt::DropAction action
                     // we move only if src and dest differ
                     if (srcColl.compare(destColl))
                     {
-                        Kanki::RodsObjEntryPtr sourceEntryPtr = this->resolvePathToEntry(objPath.toStdString());
+                        std::vector<RodsObjTreeItem*> sourceItems = this->resolvePathToItems(objPathStr);
+                        Kanki::RodsObjEntryPtr sourceEntryPtr = this->resolvePathToEntry(objPathStr);
 
                         // if we have a valid object to move
                         if (sourceEntryPtr)
                         {
                             int status = 0;
 
+                            // the object path is about to change, drop the items from the path index
+                            for (std::vector<RodsObjTreeItem*>::iterator i = sourceItems.begin(); i != sourceItems.end(); i++)
+                                this->unindexItem(*i);
+
                             if (status = this->rodsConn->moveObjToColl(sourceEntryPtr, destColl))
                             {
+                                // restore the items into the path index
+                                for (std::vector<RodsObjTreeItem*>::iterator i = sourceItems.begin(); i != sourceItems.end(); i++)
+                                    this->indexItem(*i);
+
                                 // report error
                             }
 
@@ -656,5 +869,6 @@ void RodsObjTreeModel::addMountPoint(const std::string &path)
     // signal view(s) that model is to be reset and commit
     beginResetModel();
     rootItem->appendChild(mountPoint);
+    this->indexItem(mountPoint);
     endResetModel();
 }
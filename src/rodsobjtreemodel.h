@@ -17,9 +17,10 @@
 // C++ standard library headers
 #include <iostream>
 #include <string>
+#include <vector>
 
 // boost library headers
-#include "boost/tokenizer.hpp"
+#include "boost/unordered_map.hpp"
 
 // Qt framework headers
 #include <QApplication>
@@ -32,9 +33,11 @@
 // Kanki iRODS C++ class library headers
 #include "rodsconnection.h"
 #include "rodsobjentry.h"
+#include "_rodsgenquery.h"
 
 // application headers
 #include "rodsobjtreeitem.h"
+#include "rodsprefetchthread.h"
 
 class RodsObjTreeModel : public QAbstractItemModel
 {
@@ -118,6 +121,9 @@ public:
     // Interface for resolving a rods path to an Kanki::RodsObjEntryPtr
     Kanki::RodsObjEntryPtr resolvePathToEntry(const std::string &path);
 
+    // Sets the speculative collection prefetcher for the model, null disables prefetching.
+    void setPrefetcher(RodsPrefetchThread *thePrefetcher);
+
 public slots:
 
     // Interface for requesting the model to refresh at a certain index.
@@ -128,6 +134,43 @@ public slots:
 
 private:
 
+    // Class local type for the rods path index, maps a full rods object path to the
+    // tree items representing it (the same path can be present under several mount points).
+    typedef boost::unordered_multimap<std::string, RodsObjTreeItem*> PathIndex;
+
+    // resolves a rods path to the tree items currently representing it
+    std::vector<RodsObjTreeItem*> resolvePathToItems(const std::string &path) const;
+
+    // builds a model index for an item in the tree
+    QModelIndex indexForItem(RodsObjTreeItem *item) const;
+
+    // adds an item and all of its descendants into the path index
+    void indexItem(RodsObjTreeItem *item);
+
+    // removes an item and all of its descendants from the path index
+    void unindexItem(RodsObjTreeItem *item);
+
+    // returns the path index key for an item, the mount point path or object full path
+    static std::string itemPath(RodsObjTreeItem *item);
+
+    // inserts a collection listing as the children of an item, optionally prefetching
+    // the child hints of the subcollections
+    void insertListing(const QModelIndex &parent, RodsObjTreeItem *item, const std::string &collPath,
+                       const std::vector<Kanki::RodsObjEntryPtr> &rodsColl, bool withHints);
+
+    // prefetches child counts and total data sizes for the subcollections of a listed
+    // collection with aggregated queries, so that empty collections are known up front
+    int prefetchChildHints(RodsObjTreeItem *item, const std::string &collPath);
+
+    // count of subcollections speculatively listed after a listing
+    static const int prefetchBudget;
+
+    // hash index of loaded rods object paths
+    PathIndex pathIndex;
+
+    // speculative collection prefetcher, not owned by the model
+    RodsPrefetchThread *prefetcher;
+
     // qt icon objects used in the model
     QIcon mountIcon, collIcon, dataIcon;
 
@@ -0,0 +1,366 @@
+/**
+ * @file rodsobjtreestore.cpp
+ * @brief Implementation of class RodsObjTreeStore
+ *
+ * The RodsObjTreeStore class implements a flattened node storage for
+ * the iRODS object tree, with node properties kept in contiguous arrays.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsObjTreeStore header
+#include "rodsobjtreestore.h"
+
+// initialize static class constants
+const RodsObjTreeStore::NodeId RodsObjTreeStore::InvalidNode = -1;
+const RodsObjTreeStore::NodeId RodsObjTreeStore::RootNode = 0;
+
+RodsObjTreeStore::RodsObjTreeStore()
+{
+    this->clear();
+}
+
+void RodsObjTreeStore::clear()
+{
+    // clear all node arrays
+    this->parentNode.clear();
+    this->firstChild.clear();
+    this->numChildren.clear();
+    this->blockCapacity.clear();
+    this->fetched.clear();
+    this->nameOffset.clear();
+    this->objTypes.clear();
+    this->objSizes.clear();
+    this->createTimes.clear();
+    this->modifyTimes.clear();
+    this->replNums.clear();
+    this->replStats.clear();
+    this->nameArena.clear();
+
+    this->liveNodes = this->garbageNodes = 0;
+
+    // allocate and initialize the root node
+    this->allocBlock(1);
+    this->setNode(RootNode, InvalidNode, "", UNKNOWN_OBJ_T, 0, 0, 0, 0, 0);
+    this->liveNodes = 1;
+}
+
+RodsObjTreeStore::NodeId RodsObjTreeStore::allocBlock(int count)
+{
+    NodeId first = this->parentNode.size();
+    size_t newSize = first + count;
+
+    // grow all arrays in unison
+    this->parentNode.resize(newSize, InvalidNode);
+    this->firstChild.resize(newSize, InvalidNode);
+    this->numChildren.resize(newSize, 0);
+    this->blockCapacity.resize(newSize, 0);
+    this->fetched.resize(newSize, 0);
+    this->nameOffset.resize(newSize, 0);
+    this->objTypes.resize(newSize, UNKNOWN_OBJ_T);
+    this->objSizes.resize(newSize, 0);
+    this->createTimes.resize(newSize, 0);
+    this->modifyTimes.resize(newSize, 0);
+    this->replNums.resize(newSize, 0);
+    this->replStats.resize(newSize, 0);
+
+    return (first);
+}
+
+void RodsObjTreeStore::setNode(NodeId node, NodeId parent, const char *nodeName, objType_t type, rodsLong_t size,
+                               time_t ctime, time_t mtime, int replNumber, int replStat)
+{
+    // append name into the arena
+    this->nameOffset[node] = this->nameArena.size();
+    this->nameArena.insert(this->nameArena.end(), nodeName, nodeName + strlen(nodeName) + 1);
+
+    this->parentNode[node] = parent;
+    this->firstChild[node] = InvalidNode;
+    this->numChildren[node] = 0;
+    this->blockCapacity[node] = 0;
+    this->fetched[node] = 0;
+    this->objTypes[node] = type;
+    this->objSizes[node] = size;
+    this->createTimes[node] = ctime;
+    this->modifyTimes[node] = mtime;
+    this->replNums[node] = replNumber;
+    this->replStats[node] = replStat;
+}
+
+void RodsObjTreeStore::growBlock(NodeId node, int capacity)
+{
+    NodeId oldFirst = this->firstChild[node];
+    NodeId newFirst = this->allocBlock(capacity);
+
+    // move the existing children into the new block
+    for (int i = 0; i < this->numChildren[node]; i++)
+    {
+        NodeId from = oldFirst + i, to = newFirst + i;
+
+        this->parentNode[to] = this->parentNode[from];
+        this->firstChild[to] = this->firstChild[from];
+        this->numChildren[to] = this->numChildren[from];
+        this->blockCapacity[to] = this->blockCapacity[from];
+        this->fetched[to] = this->fetched[from];
+        this->nameOffset[to] = this->nameOffset[from];
+        this->objTypes[to] = this->objTypes[from];
+        this->objSizes[to] = this->objSizes[from];
+        this->createTimes[to] = this->createTimes[from];
+        this->modifyTimes[to] = this->modifyTimes[from];
+        this->replNums[to] = this->replNums[from];
+        this->replStats[to] = this->replStats[from];
+
+        // grandchildren must point to the moved node
+        for (int j = 0; j < this->numChildren[to]; j++)
+            this->parentNode[this->firstChild[to] + j] = to;
+    }
+
+    // the old block is garbage from now on
+    this->garbageNodes += this->blockCapacity[node];
+
+    this->firstChild[node] = newFirst;
+    this->blockCapacity[node] = capacity;
+}
+
+RodsObjTreeStore::NodeId RodsObjTreeStore::addMountPoint(const std::string &path)
+{
+    int count = this->numChildren[RootNode];
+
+    // mount points are children of the root node, grow root block if necessary
+    if (count >= this->blockCapacity[RootNode])
+        this->growBlock(RootNode, count ? count * 2 : 4);
+
+    NodeId node = this->firstChild[RootNode] + count;
+
+    this->setNode(node, RootNode, path.c_str(), UNKNOWN_OBJ_T, 0, 0, 0, 0, 0);
+    this->numChildren[RootNode]++;
+    this->liveNodes++;
+
+    return (node);
+}
+
+void RodsObjTreeStore::setChildren(NodeId node, const std::vector<Kanki::RodsObjEntryPtr> &entries)
+{
+    int count = entries.size();
+
+    // drop a previous listing
+    this->removeChildren(node);
+
+    // reuse the previous children block if it fits, otherwise allocate a new one
+    if (count > this->blockCapacity[node])
+    {
+        NodeId first = this->allocBlock(count);
+
+        this->garbageNodes += this->blockCapacity[node];
+        this->firstChild[node] = first;
+        this->blockCapacity[node] = count;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        Kanki::RodsObjEntryPtr entry = entries.at(i);
+
+        this->setNode(this->firstChild[node] + i, node, entry->getObjectName().c_str(), entry->objType,
+                      entry->objSize, (time_t)atol(entry->createTime.c_str()), (time_t)atol(entry->modifyTime.c_str()),
+                      entry->replNum, entry->replStatus);
+    }
+
+    this->numChildren[node] = count;
+    this->fetched[node] = 1;
+    this->liveNodes += count;
+}
+
+void RodsObjTreeStore::removeChildren(NodeId node)
+{
+    // release the blocks of all the descendants
+    for (int i = 0; i < this->numChildren[node]; i++)
+        this->releaseBlock(this->firstChild[node] + i);
+
+    // the children block itself is kept for reuse
+    this->liveNodes -= this->numChildren[node];
+    this->numChildren[node] = 0;
+    this->fetched[node] = 0;
+}
+
+void RodsObjTreeStore::releaseBlock(NodeId node)
+{
+    // recurse into the children
+    for (int i = 0; i < this->numChildren[node]; i++)
+        this->releaseBlock(this->firstChild[node] + i);
+
+    this->liveNodes -= this->numChildren[node];
+    this->garbageNodes += this->blockCapacity[node];
+
+    this->firstChild[node] = InvalidNode;
+    this->numChildren[node] = 0;
+    this->blockCapacity[node] = 0;
+}
+
+bool RodsObjTreeStore::isFetched(NodeId node) const
+{
+    return (this->fetched[node] != 0);
+}
+
+RodsObjTreeStore::NodeId RodsObjTreeStore::parent(NodeId node) const
+{
+    return (this->parentNode[node]);
+}
+
+RodsObjTreeStore::NodeId RodsObjTreeStore::child(NodeId node, int row) const
+{
+    // sanity check for row bounds
+    if (row < 0 || row >= this->numChildren[node])
+        return (InvalidNode);
+
+    // children are contiguous, the next sibling is always the next node
+    return (this->firstChild[node] + row);
+}
+
+int RodsObjTreeStore::childCount(NodeId node) const
+{
+    return (this->numChildren[node]);
+}
+
+int RodsObjTreeStore::row(NodeId node) const
+{
+    // root node has no parent
+    if (node == RootNode)
+        return (0);
+
+    return (node - this->firstChild[this->parentNode[node]]);
+}
+
+bool RodsObjTreeStore::isMountPoint(NodeId node) const
+{
+    return (this->parentNode[node] == RootNode);
+}
+
+objType_t RodsObjTreeStore::objType(NodeId node) const
+{
+    // mount points are rods collections
+    if (this->isMountPoint(node))
+        return (COLL_OBJ_T);
+
+    return ((objType_t)this->objTypes[node]);
+}
+
+const char* RodsObjTreeStore::name(NodeId node) const
+{
+    return (&this->nameArena[this->nameOffset[node]]);
+}
+
+std::string RodsObjTreeStore::fullPath(NodeId node) const
+{
+    std::vector<NodeId> pathNodes;
+    std::string path;
+
+    // collect the nodes up to the mount point
+    for (NodeId cur = node; cur != RootNode && cur != InvalidNode; cur = this->parentNode[cur])
+        pathNodes.push_back(cur);
+
+    // construct path starting from the mount point path
+    for (std::vector<NodeId>::reverse_iterator i = pathNodes.rbegin(); i != pathNodes.rend(); i++)
+    {
+        if (i != pathNodes.rbegin() && (path.empty() || path.at(path.length() - 1) != '/'))
+            path += "/";
+
+        path += this->name(*i);
+    }
+
+    return (path);
+}
+
+rodsLong_t RodsObjTreeStore::objSize(NodeId node) const
+{
+    return (this->objSizes[node]);
+}
+
+time_t RodsObjTreeStore::createTime(NodeId node) const
+{
+    return (this->createTimes[node]);
+}
+
+time_t RodsObjTreeStore::modifyTime(NodeId node) const
+{
+    return (this->modifyTimes[node]);
+}
+
+int RodsObjTreeStore::replNum(NodeId node) const
+{
+    return (this->replNums[node]);
+}
+
+int RodsObjTreeStore::replStatus(NodeId node) const
+{
+    return (this->replStats[node]);
+}
+
+size_t RodsObjTreeStore::nodeCount() const
+{
+    return (this->liveNodes);
+}
+
+size_t RodsObjTreeStore::garbageCount() const
+{
+    return (this->garbageNodes);
+}
+
+void RodsObjTreeStore::compact()
+{
+    RodsObjTreeStore compacted;
+
+    // copy the live tree breadth-first into a fresh store
+    this->copyChildren(RootNode, &compacted, RootNode);
+
+    // take over the compacted arrays
+    this->parentNode.swap(compacted.parentNode);
+    this->firstChild.swap(compacted.firstChild);
+    this->numChildren.swap(compacted.numChildren);
+    this->blockCapacity.swap(compacted.blockCapacity);
+    this->fetched.swap(compacted.fetched);
+    this->nameOffset.swap(compacted.nameOffset);
+    this->objTypes.swap(compacted.objTypes);
+    this->objSizes.swap(compacted.objSizes);
+    this->createTimes.swap(compacted.createTimes);
+    this->modifyTimes.swap(compacted.modifyTimes);
+    this->replNums.swap(compacted.replNums);
+    this->replStats.swap(compacted.replStats);
+    this->nameArena.swap(compacted.nameArena);
+
+    this->liveNodes = compacted.liveNodes;
+    this->garbageNodes = 0;
+}
+
+void RodsObjTreeStore::copyChildren(NodeId node, RodsObjTreeStore *dest, NodeId destNode) const
+{
+    int count = this->numChildren[node];
+
+    if (!count)
+    {
+        dest->fetched[destNode] = this->fetched[node];
+        return;
+    }
+
+    // allocate an exactly sized block for the children
+    NodeId first = dest->allocBlock(count);
+    dest->firstChild[destNode] = first;
+    dest->numChildren[destNode] = count;
+    dest->blockCapacity[destNode] = count;
+    dest->fetched[destNode] = this->fetched[node];
+    dest->liveNodes += count;
+
+    for (int i = 0; i < count; i++)
+    {
+        NodeId from = this->firstChild[node] + i;
+
+        dest->setNode(first + i, destNode, this->name(from), (objType_t)this->objTypes[from], this->objSizes[from],
+                      this->createTimes[from], this->modifyTimes[from], this->replNums[from], this->replStats[from]);
+    }
+
+    // recurse after the sibling block so that siblings stay contiguous
+    for (int i = 0; i < count; i++)
+        this->copyChildren(this->firstChild[node] + i, dest, first + i);
+}
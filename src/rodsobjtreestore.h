@@ -0,0 +1,144 @@
+/**
+ * @file rodsobjtreestore.h
+ * @brief Definition of class RodsObjTreeStore
+ *
+ * The RodsObjTreeStore class implements a flattened node storage for
+ * the iRODS object tree, with node properties kept in contiguous arrays.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSOBJTREESTORE_H
+#define RODSOBJTREESTORE_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// ANSI C standard library headers
+#include <cstdlib>
+#include <ctime>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsobjentry.h"
+
+class RodsObjTreeStore
+{
+
+public:
+
+    // Class local type for node identifiers, a node id is an index to the node arrays.
+    typedef int NodeId;
+
+    // Static class constants for the invalid node id and the root node id.
+    static const NodeId InvalidNode;
+    static const NodeId RootNode;
+
+    // Constructor initializes the store with a root node only.
+    RodsObjTreeStore();
+
+    // Adds a mount point node for a rods collection path under the root node.
+    NodeId addMountPoint(const std::string &path);
+
+    // Sets the children of a node from a rods collection listing. The children of a node are
+    // stored as one contiguous block, the storage of a previous listing is reused if it fits.
+    void setChildren(NodeId node, const std::vector<Kanki::RodsObjEntryPtr> &entries);
+
+    // Removes the children of a node and all of their descendants.
+    void removeChildren(NodeId node);
+
+    // Interface for querying whether a collection listing has been stored for a node.
+    bool isFetched(NodeId node) const;
+
+    // Interface for querying the parent node id of a node.
+    NodeId parent(NodeId node) const;
+
+    // Interface for querying the node id of the child of a node at a row.
+    NodeId child(NodeId node, int row) const;
+
+    // Interface for querying the child count of a node.
+    int childCount(NodeId node) const;
+
+    // Interface for querying the row of a node at its parent.
+    int row(NodeId node) const;
+
+    // Interface for querying whether a node is a mount point.
+    bool isMountPoint(NodeId node) const;
+
+    // Interface for querying the rods object type of a node, mount points are collections.
+    objType_t objType(NodeId node) const;
+
+    // Interface for querying the name of a node (last path component, or mount path).
+    const char* name(NodeId node) const;
+
+    // Constructs the full rods path of a node.
+    std::string fullPath(NodeId node) const;
+
+    // Interfaces for querying the rods object properties of a node.
+    rodsLong_t objSize(NodeId node) const;
+    time_t createTime(NodeId node) const;
+    time_t modifyTime(NodeId node) const;
+    int replNum(NodeId node) const;
+    int replStatus(NodeId node) const;
+
+    // Interface for querying the count of nodes in use.
+    size_t nodeCount() const;
+
+    // Interface for querying the count of node slots freed but not reclaimed.
+    size_t garbageCount() const;
+
+    // Compacts the node arrays by reclaiming freed node slots and name storage.
+    // Invalidates all node ids except the root node id.
+    void compact();
+
+    // Clears the store back into having just the root node.
+    void clear();
+
+private:
+
+    // appends an uninitialized block of nodes into the arrays, returns first node id
+    NodeId allocBlock(int count);
+
+    // moves the children block of a node to a new larger block at the end of the arrays
+    void growBlock(NodeId node, int capacity);
+
+    // sets the properties of a node
+    void setNode(NodeId node, NodeId parentNode, const char *nodeName, objType_t type, rodsLong_t size,
+                 time_t ctime, time_t mtime, int replNumber, int replStat);
+
+    // frees the children block of a node recursively
+    void releaseBlock(NodeId node);
+
+    // copies a subtree into another store, used in compaction
+    void copyChildren(NodeId node, RodsObjTreeStore *dest, NodeId destNode) const;
+
+    // node tree structure arrays
+    std::vector<NodeId> parentNode;
+    std::vector<NodeId> firstChild;
+    std::vector<int> numChildren;
+    std::vector<int> blockCapacity;
+    std::vector<char> fetched;
+
+    // node rods object entry column arrays
+    std::vector<size_t> nameOffset;
+    std::vector<char> objTypes;
+    std::vector<rodsLong_t> objSizes;
+    std::vector<time_t> createTimes;
+    std::vector<time_t> modifyTimes;
+    std::vector<int> replNums;
+    std::vector<char> replStats;
+
+    // arena for the zero terminated node names
+    std::vector<char> nameArena;
+
+    // count of node slots in use and freed
+    size_t liveNodes, garbageNodes;
+};
+
+#endif // RODSOBJTREESTORE_H
@@ -0,0 +1,173 @@
+/**
+ * @file rodsprefetchthread.cpp
+ * @brief Implementation of class RodsPrefetchThread
+ *
+ * The RodsPrefetchThread class extends the Qt thread management class
+ * QThread and implements a low priority worker thread which speculatively
+ * lists iRODS collections the user is likely to expand next.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// application class RodsPrefetchThread header
+#include "rodsprefetchthread.h"
+
+// initialize static class constants
+const time_t RodsPrefetchThread::maxAge = 60;
+
+RodsPrefetchThread::RodsPrefetchThread(Kanki::RodsConnection *theConn, unsigned int maxPending,
+                                       unsigned int maxCached)
+    : QThread()
+{
+    this->conn = new Kanki::RodsConnection(theConn);
+    this->pendingMax = maxPending;
+    this->cachedMax = maxCached;
+    this->stopRequested = false;
+    this->inFlightInvalidated = false;
+}
+
+RodsPrefetchThread::~RodsPrefetchThread()
+{
+    // make sure the thread is done with the connection
+    this->stop();
+    this->wait();
+
+    delete (this->conn);
+}
+
+void RodsPrefetchThread::enqueue(const std::string &collPath)
+{
+    boost::lock_guard<boost::mutex> lock(this->queueMutex);
+
+    // if already cached or pending, there is nothing to do
+    if (this->cache.find(collPath) != this->cache.end() ||
+            std::find(this->pending.begin(), this->pending.end(), collPath) != this->pending.end())
+        return;
+
+    // stay within budget by dropping the oldest prediction
+    if (this->pending.size() >= this->pendingMax)
+        this->pending.pop_front();
+
+    this->pending.push_back(collPath);
+    this->queueCond.notify_one();
+}
+
+bool RodsPrefetchThread::takeListing(const std::string &collPath, std::vector<Kanki::RodsObjEntryPtr> *collObjs)
+{
+    boost::lock_guard<boost::mutex> lock(this->queueMutex);
+    boost::unordered_map<std::string, RodsPrefetchThread::Listing>::iterator i = this->cache.find(collPath);
+
+    if (i == this->cache.end())
+        return (false);
+
+    bool fresh = (time(NULL) - i->second.fetchTime) <= maxAge;
+
+    // a listing is used only once, the model owns it from here on
+    if (fresh)
+        collObjs->swap(i->second.collObjs);
+
+    this->cache.erase(i);
+    this->cacheOrder.erase(std::find(this->cacheOrder.begin(), this->cacheOrder.end(), collPath));
+
+    return (fresh);
+}
+
+void RodsPrefetchThread::invalidate(const std::string &collPath)
+{
+    boost::lock_guard<boost::mutex> lock(this->queueMutex);
+
+    if (this->cache.erase(collPath))
+        this->cacheOrder.erase(std::find(this->cacheOrder.begin(), this->cacheOrder.end(), collPath));
+
+    this->pending.erase(std::remove(this->pending.begin(), this->pending.end(), collPath), this->pending.end());
+
+    // a listing already being read may predate the change, it must not be cached
+    if (this->inFlight == collPath)
+        this->inFlightInvalidated = true;
+}
+
+void RodsPrefetchThread::stop()
+{
+    boost::lock_guard<boost::mutex> lock(this->queueMutex);
+
+    this->stopRequested = true;
+    this->pending.clear();
+    this->queueCond.notify_all();
+}
+
+void RodsPrefetchThread::run()
+{
+    int status = 0;
+
+    // open the parallel connection for prefetching and authenticate
+    if ((status = this->conn->connect()) < 0)
+    {
+        reportError("Prefetch failed", "Open parallel connection failed", status);
+        return;
+    }
+
+    else if ((status = this->conn->login()) < 0)
+    {
+        reportError("Prefetch failed", "Authentication failed", status);
+        this->conn->disconnect();
+        return;
+    }
+
+    for (;;)
+    {
+        std::string collPath;
+
+        // wait for the next request
+        {
+            boost::unique_lock<boost::mutex> lock(this->queueMutex);
+
+            while (this->pending.empty() && !this->stopRequested)
+                this->queueCond.wait(lock);
+
+            if (this->stopRequested)
+                break;
+
+            // predictions are served in request order
+            collPath = this->pending.front();
+            this->pending.pop_front();
+
+            this->inFlight = collPath;
+            this->inFlightInvalidated = false;
+        }
+
+        RodsPrefetchThread::Listing listing;
+
+        // speculative listing failures are not errors for the user
+        status = this->conn->readColl(collPath, &listing.collObjs);
+        listing.fetchTime = time(NULL);
+
+        // store the listing into the cache while evicting the oldest listings
+        {
+            boost::lock_guard<boost::mutex> lock(this->queueMutex);
+            bool invalidated = this->inFlightInvalidated;
+
+            this->inFlight.clear();
+            this->inFlightInvalidated = false;
+
+            // drop failed listings and listings invalidated after the request was taken
+            if (status < 0 || invalidated)
+                continue;
+
+            if (this->cache.find(collPath) == this->cache.end())
+                this->cacheOrder.push_back(collPath);
+
+            this->cache[collPath] = listing;
+
+            while (this->cacheOrder.size() > this->cachedMax)
+            {
+                this->cache.erase(this->cacheOrder.front());
+                this->cacheOrder.pop_front();
+            }
+        }
+    }
+
+    this->conn->disconnect();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file rodsprefetchthread.h
+ * @brief Definition of class RodsPrefetchThread
+ *
+ * The RodsPrefetchThread class extends the Qt thread management class
+ * QThread and implements a low priority worker thread which speculatively
+ * lists iRODS collections the user is likely to expand next.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSPREFETCHTHREAD_H
+#define RODSPREFETCHTHREAD_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+// ANSI C standard library headers
+#include <ctime>
+
+// boost library headers
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/unordered_map.hpp>
+
+// Qt framework headers
+#include <QThread>
+#include <QString>
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsobjentry.h"
+
+class RodsPrefetchThread : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor initializes the prefetch thread with its own rods connection and a budget
+    // of pending collection listings and cached collection listings.
+    RodsPrefetchThread(Kanki::RodsConnection *theConn, unsigned int maxPending = 16, unsigned int maxCached = 64);
+
+    ~RodsPrefetchThread();
+
+    // Requests a speculative listing of a rods collection. When the pending budget is exhausted
+    // the oldest pending request is dropped.
+    void enqueue(const std::string &collPath);
+
+    // Takes a prefetched collection listing out of the cache, returns false if there is
+    // no listing for the collection or if it is too old to be used.
+    bool takeListing(const std::string &collPath, std::vector<Kanki::RodsObjEntryPtr> *collObjs);
+
+    // Drops a collection listing from the cache and from the pending requests. A listing
+    // in flight for the collection is discarded when it completes.
+    void invalidate(const std::string &collPath);
+
+    // Requests the thread to finish, pending requests are dropped.
+    void stop();
+
+signals:
+
+    // Qt signal for reporting errors to ui, it signals out a message,
+    // an error string and an error code.
+    void reportError(QString msgStr, QString errorStr, int errorCode);
+
+private:
+
+    // Class local private data structure for a cached collection listing.
+    struct Listing {
+        time_t fetchTime;
+        std::vector<Kanki::RodsObjEntryPtr> collObjs;
+    };
+
+    // Overrides superclass virtual function, executes the prefetch
+    // work in a thread instantiated with the thread object.
+    void run() Q_DECL_OVERRIDE;
+
+    // maximum age in seconds of a usable cached listing
+    static const time_t maxAge;
+
+    // pointer to the rods connection object of the thread
+    Kanki::RodsConnection *conn;
+
+    // pending and cached collection budgets
+    unsigned int pendingMax, cachedMax;
+
+    // whether the thread has been requested to stop
+    bool stopRequested;
+
+    // pending collection paths in request order
+    std::deque<std::string> pending;
+
+    // collection path being listed by the thread and whether it
+    // has been invalidated while the listing was in flight
+    std::string inFlight;
+    bool inFlightInvalidated;
+
+    // cached collection listings and their insertion order for eviction
+    boost::unordered_map<std::string, RodsPrefetchThread::Listing> cache;
+    std::deque<std::string> cacheOrder;
+
+    // a boost mutex and condition for the request queue and cache
+    boost::mutex queueMutex;
+    boost::condition_variable queueCond;
+};
+
+#endif // RODSPREFETCHTHREAD_H
@@ -0,0 +1,109 @@
+/**
+ * @file rodsquerycache.cpp
+ * @brief Implementation of Kanki library class RodsQueryCache
+ *
+ * The Kanki class RodsQueryCache implements a cache of iRODS query
+ * results keyed by a normalized query signature, with a time to live
+ * for each entry and invalidation by the scope of catalog changes.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsQueryCache header
+#include "rodsquerycache.h"
+
+namespace Kanki {
+
+RodsQueryCache::RodsQueryCache(unsigned int maxEntries)
+{
+    this->maxEntries = maxEntries;
+}
+
+bool RodsQueryCache::lookup(const std::string &signature, Kanki::RodsQueryResult *dest)
+{
+    boost::unique_lock<boost::mutex> lock(this->cacheMutex);
+    boost::unordered_map<std::string, RodsQueryCache::Entry>::iterator i = this->entries.find(signature);
+
+    if (i == this->entries.end())
+        return (false);
+
+    // expired entries are dropped on lookup
+    if (i->second.expires <= time(NULL))
+    {
+        this->entries.erase(i);
+        return (false);
+    }
+
+    *dest = i->second.result;
+
+    return (true);
+}
+
+void RodsQueryCache::store(const std::string &signature, const std::vector<int> &rodsAttrs,
+                           const Kanki::RodsQueryResult &result, int ttl)
+{
+    boost::unique_lock<boost::mutex> lock(this->cacheMutex);
+    time_t now = time(NULL);
+
+    // make room for the entry, first by dropping expired ones, then all
+    if (this->entries.size() >= this->maxEntries)
+        this->expire(now);
+
+    if (this->entries.size() >= this->maxEntries)
+        this->entries.clear();
+
+    RodsQueryCache::Entry &entry = this->entries[signature];
+
+    entry.result = result;
+    entry.expires = now + ttl;
+    entry.scopes = 0;
+
+    for (unsigned int i = 0; i < rodsAttrs.size(); i++)
+        entry.scopes |= RodsQueryCache::attributeScope(rodsAttrs.at(i));
+}
+
+void RodsQueryCache::invalidate(int scopes)
+{
+    boost::unique_lock<boost::mutex> lock(this->cacheMutex);
+
+    for (boost::unordered_map<std::string, RodsQueryCache::Entry>::iterator i = this->entries.begin();
+         i != this->entries.end();)
+    {
+        if (i->second.scopes & scopes)
+            i = this->entries.erase(i);
+
+        else
+            i++;
+    }
+}
+
+void RodsQueryCache::expire(time_t now)
+{
+    for (boost::unordered_map<std::string, RodsQueryCache::Entry>::iterator i = this->entries.begin();
+         i != this->entries.end();)
+    {
+        if (i->second.expires <= now)
+            i = this->entries.erase(i);
+
+        else
+            i++;
+    }
+}
+
+RodsQueryCache::Scope RodsQueryCache::attributeScope(int rodsAttr)
+{
+    // data object and collection attributes
+    if (rodsAttr >= COL_D_DATA_ID && rodsAttr < COL_META_DATA_ATTR_NAME)
+        return (RodsQueryCache::namespaceScope);
+
+    // metadata attributes of all kinds of objects
+    if (rodsAttr >= COL_META_DATA_ATTR_NAME && rodsAttr < COL_DATA_ACCESS_TYPE)
+        return (RodsQueryCache::metadataScope);
+
+    return (RodsQueryCache::otherScope);
+}
+
+} // namespace Kanki
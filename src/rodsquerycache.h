@@ -0,0 +1,85 @@
+/**
+ * @file rodsquerycache.h
+ * @brief Definition of Kanki library class RodsQueryCache
+ *
+ * The Kanki class RodsQueryCache implements a cache of iRODS query
+ * results keyed by a normalized query signature, with a time to live
+ * for each entry and invalidation by the scope of catalog changes.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSQUERYCACHE_H
+#define RODSQUERYCACHE_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// ANSI C standard library headers
+#include <ctime>
+
+// boost library headers
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// Kanki iRODS C++ class library headers
+#include "rodsqueryresult.h"
+
+namespace Kanki {
+
+class RodsQueryCache
+{
+public:
+
+    // Class local public enumerated type for the scopes of catalog changes a cached query
+    // depends on, a query depends on the scopes of its attributes and condition attributes.
+    enum Scope { namespaceScope = 0x1, metadataScope = 0x2, otherScope = 0x4,
+                 allScopes = namespaceScope | metadataScope | otherScope };
+
+    // Constructor initializes an empty cache with the maximum count of entries.
+    RodsQueryCache(unsigned int maxEntries = 256);
+
+    // Looks up the unexpired results of a query by its signature and copies them into a result
+    // set object. Returns false if there are no results for the query.
+    bool lookup(const std::string &signature, Kanki::RodsQueryResult *dest);
+
+    // Stores the results of a query by its signature, to be valid for ttl seconds. The rods
+    // attributes of the query (selected and conditions) determine its scopes of invalidation.
+    void store(const std::string &signature, const std::vector<int> &rodsAttrs,
+               const Kanki::RodsQueryResult &result, int ttl);
+
+    // Invalidates the cached results of the queries depending on the given scopes, called
+    // when the catalog is changed.
+    void invalidate(int scopes = RodsQueryCache::allScopes);
+
+    // Returns the scope a rods attribute belongs to.
+    static RodsQueryCache::Scope attributeScope(int rodsAttr);
+
+private:
+
+    // Class local private data structure for a cache entry.
+    struct Entry {
+        Kanki::RodsQueryResult result;
+        time_t expires;
+        int scopes;
+    };
+
+    // drops expired entries, called with the cache mutex locked
+    void expire(time_t now);
+
+    // maximum count of entries
+    unsigned int maxEntries;
+
+    // cache entries keyed by query signature, protected by the mutex
+    boost::unordered_map<std::string, RodsQueryCache::Entry> entries;
+    boost::mutex cacheMutex;
+};
+
+} // namespace Kanki
+
+#endif // RODSQUERYCACHE_H
@@ -0,0 +1,234 @@
+/**
+ * @file rodsqueryresult.cpp
+ * @brief Implementation of Kanki library class RodsQueryResult
+ *
+ * The Kanki class RodsQueryResult provides a columnar storage for the
+ * results of an iRODS query, with the values of each column kept in
+ * one contiguous character arena.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsQueryResult header
+#include "rodsqueryresult.h"
+
+namespace Kanki {
+
+// initialize static class constants
+const int RodsQueryResult::integerAttrs[] = { COL_D_DATA_ID, COL_DATA_REPL_NUM, COL_DATA_SIZE, COL_D_CREATE_TIME,
+                                              COL_D_MODIFY_TIME, COL_COLL_ID, COL_COLL_CREATE_TIME,
+                                              COL_COLL_MODIFY_TIME, COL_META_DATA_CREATE_TIME,
+                                              COL_META_DATA_MODIFY_TIME, COL_RULE_EXEC_ID, COL_RULE_EXEC_TIME,
+                                              COL_RULE_EXEC_LAST_EXE_TIME };
+const int RodsQueryResult::numIntegerAttrs = sizeof (RodsQueryResult::integerAttrs) / sizeof (int);
+
+RodsQueryResult::RodsQueryResult()
+{
+}
+
+void RodsQueryResult::reset(const std::vector<int> &rodsAttrs)
+{
+    this->attrs = rodsAttrs;
+
+    this->columns.clear();
+    this->columns.resize(rodsAttrs.size());
+
+    for (unsigned int i = 0; i < rodsAttrs.size(); i++)
+        this->columns.at(i).isInteger = RodsQueryResult::isIntegerAttribute(rodsAttrs.at(i));
+}
+
+void RodsQueryResult::clear()
+{
+    // keep the allocated storage for reuse
+    for (unsigned int i = 0; i < this->columns.size(); i++)
+    {
+        this->columns.at(i).arena.clear();
+        this->columns.at(i).offsets.clear();
+        this->columns.at(i).ints.clear();
+    }
+}
+
+void RodsQueryResult::append(int attrIndex, const char *value)
+{
+    RodsQueryResult::Column &col = this->columns.at(attrIndex);
+
+    // value starts at the end of the arena, copy including terminator
+    col.offsets.push_back(col.arena.size());
+    col.arena.insert(col.arena.end(), value, value + strlen(value) + 1);
+
+    // integer values are decoded once here
+    if (col.isInteger)
+        col.ints.push_back(strtoll(value, NULL, 10));
+}
+
+void RodsQueryResult::appendRows(const RodsQueryResult &other, size_t maxRows)
+{
+    size_t rows = other.rowCount();
+
+    if (maxRows && maxRows < rows)
+        rows = maxRows;
+
+    if (!rows)
+        return;
+
+    for (unsigned int i = 0; i < this->columns.size() && i < other.columns.size(); i++)
+    {
+        RodsQueryResult::Column &col = this->columns.at(i);
+        const RodsQueryResult::Column &from = other.columns.at(i);
+        size_t base = col.arena.size();
+        size_t end = rows < from.offsets.size() ? from.offsets.at(rows) : from.arena.size();
+
+        // copy the values of the rows in one go and rebase their offsets
+        col.arena.insert(col.arena.end(), from.arena.begin(), from.arena.begin() + end);
+
+        for (size_t j = 0; j < rows; j++)
+            col.offsets.push_back(base + from.offsets.at(j));
+
+        // decoded values are copied as they are
+        if (col.isInteger && from.isInteger)
+            col.ints.insert(col.ints.end(), from.ints.begin(), from.ints.begin() + rows);
+
+        else if (col.isInteger)
+            for (size_t j = 0; j < rows; j++)
+                col.ints.push_back(strtoll(&from.arena.at(from.offsets.at(j)), NULL, 10));
+    }
+}
+
+size_t RodsQueryResult::rowCount() const
+{
+    // all columns have the same count of values
+    if (this->columns.empty())
+        return (0);
+
+    return (this->columns.front().offsets.size());
+}
+
+int RodsQueryResult::attrCount() const
+{
+    return (this->attrs.size());
+}
+
+int RodsQueryResult::attributeIndex(int rodsAttr) const
+{
+    // simply iterate through
+    for (unsigned int i = 0; i < this->attrs.size(); i++)
+    {
+        if (this->attrs.at(i) == rodsAttr)
+            return (i);
+    }
+
+    // otherwise search failed, return -1
+    return (-1);
+}
+
+bool RodsQueryResult::hasAttributes(const std::vector<int> &rodsAttrs) const
+{
+    return (this->attrs == rodsAttrs);
+}
+
+int RodsQueryResult::attributeAtIndex(int attrIndex) const
+{
+    return (this->attrs.at(attrIndex));
+}
+
+boost::string_ref RodsQueryResult::value(size_t row, int attrIndex) const
+{
+    // sanity check for bounds
+    if (attrIndex < 0 || attrIndex >= (int)this->columns.size() || row >= this->columns.at(attrIndex).offsets.size())
+        return (boost::string_ref());
+
+    const RodsQueryResult::Column &col = this->columns.at(attrIndex);
+    size_t begin = col.offsets.at(row);
+
+    // value ends at the start of the next value, minus the terminator
+    size_t end = (row + 1 < col.offsets.size() ? col.offsets.at(row + 1) : col.arena.size()) - 1;
+
+    return (boost::string_ref(&col.arena.at(begin), end - begin));
+}
+
+boost::string_ref RodsQueryResult::valueForAttr(size_t row, int rodsAttr) const
+{
+    return (this->value(row, this->attributeIndex(rodsAttr)));
+}
+
+const char* RodsQueryResult::cstr(size_t row, int attrIndex) const
+{
+    // sanity check for bounds
+    if (attrIndex < 0 || attrIndex >= (int)this->columns.size() || row >= this->columns.at(attrIndex).offsets.size())
+        return ("");
+
+    const RodsQueryResult::Column &col = this->columns.at(attrIndex);
+
+    return (&col.arena.at(col.offsets.at(row)));
+}
+
+rodsLong_t RodsQueryResult::int64Value(size_t row, int attrIndex) const
+{
+    // integer columns are already decoded
+    if (this->isIntegerColumn(attrIndex))
+    {
+        const std::vector<rodsLong_t> &ints = this->columns.at(attrIndex).ints;
+
+        return (row < ints.size() ? ints.at(row) : 0);
+    }
+
+    return (strtoll(this->cstr(row, attrIndex), NULL, 10));
+}
+
+double RodsQueryResult::doubleValue(size_t row, int attrIndex) const
+{
+    return (strtod(this->cstr(row, attrIndex), NULL));
+}
+
+bool RodsQueryResult::isIntegerColumn(int attrIndex) const
+{
+    if (attrIndex < 0 || attrIndex >= (int)this->columns.size())
+        return (false);
+
+    return (this->columns.at(attrIndex).isInteger);
+}
+
+const std::vector<rodsLong_t>* RodsQueryResult::integerColumn(int attrIndex) const
+{
+    if (!this->isIntegerColumn(attrIndex))
+        return (NULL);
+
+    return (&this->columns.at(attrIndex).ints);
+}
+
+bool RodsQueryResult::isIntegerAttribute(int rodsAttr)
+{
+    for (int i = 0; i < RodsQueryResult::numIntegerAttrs; i++)
+    {
+        if (RodsQueryResult::integerAttrs[i] == rodsAttr)
+            return (true);
+    }
+
+    return (false);
+}
+
+std::vector<std::string> RodsQueryResult::column(int attrIndex) const
+{
+    std::vector<std::string> values;
+
+    if (attrIndex < 0 || attrIndex >= (int)this->columns.size())
+        return (values);
+
+    values.reserve(this->rowCount());
+
+    for (size_t i = 0; i < this->columns.at(attrIndex).offsets.size(); i++)
+        values.push_back(this->cstr(i, attrIndex));
+
+    return (values);
+}
+
+void RodsQueryResult::swap(RodsQueryResult &other)
+{
+    this->attrs.swap(other.attrs);
+    this->columns.swap(other.columns);
+}
+
+} // namespace Kanki
@@ -0,0 +1,129 @@
+/**
+ * @file rodsqueryresult.h
+ * @brief Definition of Kanki library class RodsQueryResult
+ *
+ * The Kanki class RodsQueryResult provides a columnar storage for the
+ * results of an iRODS query, with the values of each column kept in
+ * one contiguous character arena, and known integer and time columns
+ * decoded once into integer arrays.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSQUERYRESULT_H
+#define RODSQUERYRESULT_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// ANSI C standard library headers
+#include <cstring>
+#include <cstdlib>
+
+// boost library headers
+#include <boost/utility/string_ref.hpp>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+namespace Kanki {
+
+class RodsQueryResult
+{
+public:
+
+    // Constructor initializes an empty result set without attributes.
+    RodsQueryResult();
+
+    // Clears the result set and sets up a column for each rods attribute.
+    void reset(const std::vector<int> &rodsAttrs);
+
+    // Clears the result values while keeping the columns.
+    void clear();
+
+    // Appends a zero terminated value into the column at attribute index. Values
+    // must be appended row by row, one value per column.
+    void append(int attrIndex, const char *value);
+
+    // Appends at most maxRows rows from another result set with the same attributes,
+    // zero means all the rows.
+    void appendRows(const RodsQueryResult &other, size_t maxRows = 0);
+
+    // Returns the row count of the result set.
+    size_t rowCount() const;
+
+    // Returns the attribute count of the result set.
+    int attrCount() const;
+
+    // Interface for querying the index of a specified attribute, -1 if not present.
+    int attributeIndex(int rodsAttr) const;
+
+    // Interface for querying whether the result set has exactly the given attributes.
+    bool hasAttributes(const std::vector<int> &rodsAttrs) const;
+
+    // Interface for querying the attribute id at the specific index.
+    int attributeAtIndex(int attrIndex) const;
+
+    // Interface for accessing a value at a row and attribute index as a string view.
+    boost::string_ref value(size_t row, int attrIndex) const;
+
+    // Interface for accessing a value at a row for a rods attribute as a string view.
+    boost::string_ref valueForAttr(size_t row, int rodsAttr) const;
+
+    // Interface for accessing a value at a row and attribute index as a zero terminated string,
+    // for passing values on to C APIs. Returns an empty string when out of bounds.
+    const char* cstr(size_t row, int attrIndex) const;
+
+    // Interfaces for decoding a value at a row and attribute index as an integer or as a floating
+    // point number, for numeric and aggregated attributes. Empty or out of bounds values give zero.
+    // Values of integer columns are not decoded again.
+    rodsLong_t int64Value(size_t row, int attrIndex) const;
+    double doubleValue(size_t row, int attrIndex) const;
+
+    // Interface for querying whether the column at attribute index is an integer column.
+    bool isIntegerColumn(int attrIndex) const;
+
+    // Interface for accessing the decoded values of an integer column, for sorting and aggregating
+    // without conversions. Returns NULL if the column is not an integer column.
+    const std::vector<rodsLong_t>* integerColumn(int attrIndex) const;
+
+    // Interface for querying whether the values of a rods attribute are integers (ids, sizes,
+    // counts and time stamps), the columns of these attributes are decoded on append.
+    static bool isIntegerAttribute(int rodsAttr);
+
+    // Interface for getting a copy of a column as a vector of strings.
+    std::vector<std::string> column(int attrIndex) const;
+
+    // Swaps the contents of two result sets.
+    void swap(RodsQueryResult &other);
+
+private:
+
+    // Class local private data structure for a result column, the values are stored zero
+    // terminated one after another in the arena, the offsets point to the value starts.
+    // Integer columns also have the decoded values.
+    struct Column {
+        std::vector<char> arena;
+        std::vector<size_t> offsets;
+        std::vector<rodsLong_t> ints;
+        bool isInteger;
+    };
+
+    // rods attributes with integer values
+    static const int integerAttrs[];
+    static const int numIntegerAttrs;
+
+    // rods attribute codes of the columns
+    std::vector<int> attrs;
+
+    // result columns
+    std::vector<RodsQueryResult::Column> columns;
+};
+
+} // namespace Kanki
+
+#endif // RODSQUERYRESULT_H
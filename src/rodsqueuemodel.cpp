@@ -28,6 +28,27 @@ RodsQueueModel::RodsQueueModel(Kanki::RodsConnection *rodsConn, QObject *parent)
 {
     // set conn pointer
     conn = rodsConn;
+    timer = NULL;
+
+    // build the queue query once, it is re-executed on every refresh
+    queueQuery = new Kanki::RodsGenQuery(conn);
+
+    // set gen query attributes
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_ID);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_NAME);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_REI_FILE_PATH);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_USER_NAME);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_ADDRESS);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_TIME);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_FREQUENCY);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_PRIORITY);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_ESTIMATED_EXE_TIME);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_NOTIFICATION_ADDR);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_LAST_EXE_TIME);
+    queueQuery->addQueryAttribute(COL_RULE_EXEC_STATUS);
+
+    // set query condition, user name
+    queueQuery->addQueryCondition(COL_RULE_EXEC_USER_NAME, Kanki::RodsGenQuery::isEqual, conn->rodsUser());
 
     // initialize queue model with a refresh
     refreshQueue();
@@ -44,6 +65,7 @@ RodsQueueModel::RodsQueueModel(Kanki::RodsConnection *rodsConn, QObject *parent)
 RodsQueueModel::~RodsQueueModel()
 {
     delete (timer);
+    delete (queueQuery);
 }
 
 int RodsQueueModel::rowCount(const QModelIndex &parent) const
@@ -51,11 +73,8 @@ int RodsQueueModel::rowCount(const QModelIndex &parent) const
     // ignore index argument, unused in this model
     (void)parent;
 
-    // simply return vector size
-    if (!queueData.empty())
-        return (queueData.at(0).size());
-
-    return (0);
+    // simply return result set row count
+    return (queueData.rowCount());
 }
 
 int RodsQueueModel::columnCount(const QModelIndex &parent) const
@@ -75,13 +94,18 @@ QVariant RodsQueueModel::data(const QModelIndex &index, int role) const
         if (role == Qt::DisplayRole)
         {
             // check boundaries for index row and column
-            if (index.column() < (int)queueData.size())
+            if (index.column() < queueData.attrCount() && index.row() < (int)queueData.rowCount())
             {
-                if (index.row() < (int)queueData.at(index.column()).size())
-                {
-                    // simply return raw data, TODO: return formatted data
-                    return (QVariant(queueData.at(index.column()).at(index.row()).c_str()));
-                }
+                boost::string_ref value = queueData.value(index.row(), index.column());
+                int attr = queueData.attributeAtIndex(index.column());
+
+                // time stamps are formatted from the decoded values
+                if ((attr == COL_RULE_EXEC_TIME || attr == COL_RULE_EXEC_LAST_EXE_TIME) && !value.empty())
+                    return (QVariant(RodsObjTreeItem::formatDateString(
+                                         (time_t)queueData.int64Value(index.row(), index.column())).c_str()));
+
+                // otherwise return raw data
+                return (QVariant(QString::fromUtf8(value.data(), value.size())));
             }
         }
     }
@@ -121,28 +145,8 @@ void RodsQueueModel::refreshQueue()
 {
     int status = 0;
 
-    // initialize new rods gen query object
-    Kanki::RodsGenQuery query(this->conn);
-
-    // set gen query attributes
-    query.addQueryAttribute(COL_RULE_EXEC_ID);
-    query.addQueryAttribute(COL_RULE_EXEC_NAME);
-    query.addQueryAttribute(COL_RULE_EXEC_REI_FILE_PATH);
-    query.addQueryAttribute(COL_RULE_EXEC_USER_NAME);
-    query.addQueryAttribute(COL_RULE_EXEC_ADDRESS);
-    query.addQueryAttribute(COL_RULE_EXEC_TIME);
-    query.addQueryAttribute(COL_RULE_EXEC_FREQUENCY);
-    query.addQueryAttribute(COL_RULE_EXEC_PRIORITY);
-    query.addQueryAttribute(COL_RULE_EXEC_ESTIMATED_EXE_TIME);
-    query.addQueryAttribute(COL_RULE_EXEC_NOTIFICATION_ADDR);
-    query.addQueryAttribute(COL_RULE_EXEC_LAST_EXE_TIME);
-    query.addQueryAttribute(COL_RULE_EXEC_STATUS);
-
-    // set query condition, user name
-    query.addQueryCondition(COL_RULE_EXEC_USER_NAME, Kanki::RodsGenQuery::isEqual, conn->rodsUser());
-
-    // try to execute rods gen query
-    if ((status = query.execute()) < 0)
+    // try to execute the prepared rods gen query
+    if ((status = this->queueQuery->execute()) < 0)
     {
         // when query fails, stop timer if it exists
         if (this->timer)
@@ -160,7 +164,8 @@ void RodsQueueModel::refreshQueue()
     // on success, get results and signal for data change (all data)
     else {
         beginResetModel();
-        queueData = query.getResultSet();
+        // swap the result storages, the previous one is reused by the next refresh
+        this->queueQuery->takeResult(&queueData);
         endResetModel();
     }
 }
@@ -27,6 +27,9 @@
 #include "rodsconnection.h"
 #include "_rodsgenquery.h"
 
+// application headers
+#include "rodsobjtreeitem.h"
+
 class RodsQueueModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -72,8 +75,11 @@ private:
     // pointer to rods connection object for communications
     Kanki::RodsConnection *conn;
 
-    // simple STL instantiated container for model data
-    std::vector< std::vector< std::string> > queueData;
+    // rods gen query object for the queue, executed again on every refresh
+    Kanki::RodsGenQuery *queueQuery;
+
+    // columnar result set container for model data
+    Kanki::RodsQueryResult queueData;
 
     // static class data for model column configuration
     static const char *columnNames[];
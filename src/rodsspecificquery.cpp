@@ -0,0 +1,203 @@
+/**
+ * @file rodsspecificquery.cpp
+ * @brief Implementation of Kanki library class RodsSpecificQuery
+ *
+ * The Kanki class RodsSpecificQuery provides an interface for executing
+ * an iRODS specific query (a registered SQL query) and processing its
+ * results, alongside the GenQuery interface of RodsGenQuery.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+// Kanki library class RodsSpecificQuery header
+#include "rodsspecificquery.h"
+
+namespace Kanki {
+
+// initialize static class constants
+const unsigned int RodsSpecificQuery::maxArgs = 10;
+
+RodsSpecificQuery::RodsSpecificQuery(Kanki::RodsConnection *theConn, const std::string &theSql)
+{
+    this->conn = theConn;
+    this->sql = theSql;
+
+    // by default, no row limit
+    this->rowLimit = 0;
+}
+
+bool RodsSpecificQuery::addArgument(const std::string &arg)
+{
+    // the rods api has a fixed size argument array
+    if (this->args.size() >= RodsSpecificQuery::maxArgs)
+        return (false);
+
+    this->args.push_back(arg);
+
+    return (true);
+}
+
+void RodsSpecificQuery::setZone(const std::string &zone)
+{
+    this->zoneName = zone;
+}
+
+void RodsSpecificQuery::setRowLimit(int limit)
+{
+    this->rowLimit = limit;
+}
+
+int RodsSpecificQuery::execute()
+{
+    // flush previous results, the columns are set up from the first page
+    this->results.clear();
+
+    // stream all the pages into local storage
+    return (this->executeStreaming(boost::bind(&RodsSpecificQuery::storePage, this, _1)));
+}
+
+bool RodsSpecificQuery::storePage(const Kanki::RodsGenQuery::Page &page)
+{
+    // reuse the result storage when the columns are the same
+    if (!this->results.hasAttributes(this->columnIds))
+        this->results.reset(this->columnIds);
+
+    for (int i = 0; i < page.rowCount(); i++)
+    {
+        for (int j = 0; j < page.attrCount(); j++)
+        {
+            // append result entry into the column arena
+            this->results.append(j, page.value(i, j));
+        }
+    }
+
+    // always continue to the next page
+    return (true);
+}
+
+int RodsSpecificQuery::executeStreaming(Kanki::RodsGenQuery::PageHandler pageHandler)
+{
+    specificQueryInp_t queryInput;
+    genQueryOut_t *queryOutput = NULL;
+    int status = 0, rowCount = 0;
+    bool more = true;
+
+    // zero rods api data structures
+    memset(&queryInput, 0, sizeof (specificQueryInp_t));
+
+    // the rods api doesn't modify the query strings
+    queryInput.sql = const_cast<char*>(this->sql.c_str());
+
+    for (unsigned int i = 0; i < this->args.size(); i++)
+        queryInput.args[i] = const_cast<char*>(this->args.at(i).c_str());
+
+    if (this->zoneName.length())
+        addKeyVal(&queryInput.condInput, ZONE_KW, this->zoneName.c_str());
+
+    queryInput.maxRows = MAX_SQL_ROWS;
+
+    // don't ask for more rows than we are going to fetch
+    if (this->rowLimit > 0 && this->rowLimit < queryInput.maxRows)
+        queryInput.maxRows = this->rowLimit;
+
+    // lock rods connection mutex for the duration of the continuation
+    this->conn->mutexLock();
+
+    // try to execute the specific query
+    status = rcSpecificQuery(this->conn->commPtr(), &queryInput, &queryOutput);
+
+    // iterate while there are results to process
+    while (!status && queryOutput)
+    {
+        int pageRows = queryOutput->rowCnt;
+        bool hasNext = queryOutput->continueInx != 0;
+
+        // stop at the row limit
+        if (this->rowLimit > 0 && rowCount + pageRows > this->rowLimit)
+            pageRows = this->rowLimit - rowCount;
+
+        rowCount += pageRows;
+
+        // the columns of a specific query are identified by their indices
+        if ((int)this->columnIds.size() != queryOutput->attriCnt)
+        {
+            this->columnIds.resize(queryOutput->attriCnt);
+
+            for (int i = 0; i < queryOutput->attriCnt; i++)
+                this->columnIds.at(i) = i;
+        }
+
+        // hand out the page, the handler may ask us to stop
+        if (pageRows > 0)
+            more = pageHandler(Kanki::RodsGenQuery::Page(queryOutput, &this->columnIds, pageRows));
+
+        queryInput.continueInx = queryOutput->continueInx;
+
+        freeGenQueryOut(&queryOutput);
+        queryOutput = NULL;
+
+        // if there are no more results to query, exit loop
+        if (!hasNext)
+            break;
+
+        // if the caller is done or we have reached the row limit, close the query on the server
+        if (!more || (this->rowLimit > 0 && rowCount >= this->rowLimit))
+        {
+            queryInput.maxRows = 0;
+            rcSpecificQuery(this->conn->commPtr(), &queryInput, &queryOutput);
+
+            break;
+        }
+
+        // don't ask for more rows than we are going to fetch
+        if (this->rowLimit > 0 && this->rowLimit - rowCount < queryInput.maxRows)
+            queryInput.maxRows = this->rowLimit - rowCount;
+
+        // otherwise continue fetching query results
+        status = rcSpecificQuery(this->conn->commPtr(), &queryInput, &queryOutput);
+    }
+
+    // release rods connection mutex
+    this->conn->mutexUnlock();
+
+    if (queryOutput)
+        freeGenQueryOut(&queryOutput);
+
+    clearKeyVal(&queryInput.condInput);
+
+    // let's not return no more rows found as an error
+    if (status == CAT_NO_ROWS_FOUND)
+        status = 0;
+
+    // return last rods api status to caller
+    return (status);
+}
+
+void RodsSpecificQuery::reset()
+{
+    this->args.clear();
+    this->columnIds.clear();
+    this->results.reset(std::vector<int>());
+}
+
+int RodsSpecificQuery::attrCount() const
+{
+    return (this->columnIds.size());
+}
+
+const Kanki::RodsQueryResult& RodsSpecificQuery::result() const
+{
+    return (this->results);
+}
+
+void RodsSpecificQuery::takeResult(Kanki::RodsQueryResult *dest)
+{
+    // the previous storage of the destination is reused by the next execution
+    dest->swap(this->results);
+    this->results.clear();
+}
+
+} // namespace Kanki
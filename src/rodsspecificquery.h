@@ -0,0 +1,104 @@
+/**
+ * @file rodsspecificquery.h
+ * @brief Definition of Kanki library class RodsSpecificQuery
+ *
+ * The Kanki class RodsSpecificQuery provides an interface for executing
+ * an iRODS specific query (a registered SQL query) and processing its
+ * results, alongside the GenQuery interface of RodsGenQuery.
+ *
+ * Copyright (C) 2014-2016 University of Jyväskylä. All rights reserved.
+ * License: The BSD 3-Clause License, see LICENSE file for details.
+ *
+ * @author Ilari Korhonen
+ */
+
+#ifndef RODSSPECIFICQUERY_H
+#define RODSSPECIFICQUERY_H
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// boost library headers
+#include <boost/bind.hpp>
+
+// iRODS client library headers
+#include "rodsClient.h"
+
+// Kanki iRODS C++ class library headers
+#include "rodsconnection.h"
+#include "rodsqueryresult.h"
+#include "_rodsgenquery.h"
+
+namespace Kanki {
+
+class RodsSpecificQuery
+{
+public:
+
+    // Constructor receives a pointer to a Kanki connection object and the SQL string or the
+    // alias of the specific query registered on the server.
+    RodsSpecificQuery(Kanki::RodsConnection *theConn, const std::string &theSql);
+
+    // Adds a bind argument for the query, at most maxArgs arguments can be added.
+    // Returns false if there is no room for more arguments.
+    bool addArgument(const std::string &arg);
+
+    // Sets the zone to query, by default the zone of the connection.
+    void setZone(const std::string &zone);
+
+    // Sets the maximum count of result rows fetched, zero means no limit.
+    void setRowLimit(int limit);
+
+    // Executes the specific query and fetches the results into local storage. The results
+    // have one column for each column of the SQL query, the attribute id of a column is its index.
+    int execute();
+
+    // Executes the specific query and hands out the results page by page to the page handler,
+    // without storing them. The connection is locked during the execution, so the handler
+    // must not use the same connection.
+    int executeStreaming(Kanki::RodsGenQuery::PageHandler pageHandler);
+
+    // Clears the arguments and the results.
+    void reset();
+
+    // Returns the column count of the last execution.
+    int attrCount() const;
+
+    // Interface for accessing the columnar query results without copying.
+    const Kanki::RodsQueryResult& result() const;
+
+    // Moves the query results into a result set object, leaving the query without results.
+    // The storage of the result set object is taken over by the query for reuse.
+    void takeResult(Kanki::RodsQueryResult *dest);
+
+    // Maximum count of bind arguments of a specific query.
+    static const unsigned int maxArgs;
+
+private:
+
+    // stores a page of results into the local storage
+    bool storePage(const Kanki::RodsGenQuery::Page &page);
+
+    // pointer to Kanki rods connection object
+    Kanki::RodsConnection *conn;
+
+    // SQL string or alias, bind arguments and zone of the query
+    std::string sql;
+    std::vector<std::string> args;
+    std::string zoneName;
+
+    // result row limit
+    int rowLimit;
+
+    // column ids (the column indices) of the results
+    std::vector<int> columnIds;
+
+    // columnar container for query results
+    Kanki::RodsQueryResult results;
+};
+
+} // namespace Kanki
+
+#endif // RODSSPECIFICQUERY_H